@@ -0,0 +1,964 @@
+﻿// Benchmark.cpp : DualNumberの演算子とcmath関数の計測
+//
+// 使い方: Benchmark [--format=table|csv|json] [--filter=文字列] [--counters]
+//   --format   出力形式、既定はtable（csv、jsonは機械処理用）
+//   --filter   "グループ/名前/型" にこの文字列を含む項目だけを計測する
+//   --counters ハードウェアカウンタ（サイクル、命令、分岐予測ミス、キャッシュミス）も計測する（Linuxのみ）
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "DualNumber.hpp"
+#include "FastMath.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace counting {
+
+	/**
+	* @brief 数学関数の呼び出し回数を数える値型
+	* @detail cmathのカーネルは using std::f; f(x); の形で呼んでいるので、ADLでこちらの関数が選ばれる
+	*/
+	struct counted {
+		double v;
+
+		static inline std::size_t calls = 0;
+
+		constexpr counted(double value = 0.0) : v{ value } {}
+
+		friend counted operator+(counted lhs, counted rhs) { return lhs.v + rhs.v; }
+		friend counted operator-(counted lhs, counted rhs) { return lhs.v - rhs.v; }
+		friend counted operator*(counted lhs, counted rhs) { return lhs.v * rhs.v; }
+		friend counted operator/(counted lhs, counted rhs) { return lhs.v / rhs.v; }
+		friend counted operator-(counted x) { return -x.v; }
+		counted& operator+=(counted rhs) { v += rhs.v; return *this; }
+		counted& operator-=(counted rhs) { v -= rhs.v; return *this; }
+		counted& operator*=(counted rhs) { v *= rhs.v; return *this; }
+		counted& operator/=(counted rhs) { v /= rhs.v; return *this; }
+	};
+
+	template<typename Func>
+	counted call(Func f, counted x) {
+		++counted::calls;
+		return f(x.v);
+	}
+
+	counted sqrt(counted x)  { return call([](double v) { return std::sqrt(v); }, x); }
+	counted sin(counted x)   { return call([](double v) { return std::sin(v); }, x); }
+	counted cos(counted x)   { return call([](double v) { return std::cos(v); }, x); }
+	counted tan(counted x)   { return call([](double v) { return std::tan(v); }, x); }
+	counted sinh(counted x)  { return call([](double v) { return std::sinh(v); }, x); }
+	counted cosh(counted x)  { return call([](double v) { return std::cosh(v); }, x); }
+	counted tanh(counted x)  { return call([](double v) { return std::tanh(v); }, x); }
+	counted asinh(counted x) { return call([](double v) { return std::asinh(v); }, x); }
+	counted acosh(counted x) { return call([](double v) { return std::acosh(v); }, x); }
+	counted atanh(counted x) { return call([](double v) { return std::atanh(v); }, x); }
+	counted exp(counted x)   { return call([](double v) { return std::exp(v); }, x); }
+	counted exp2(counted x)  { return call([](double v) { return std::exp2(v); }, x); }
+	counted expm1(counted x) { return call([](double v) { return std::expm1(v); }, x); }
+}
+
+namespace reference {
+
+	/**
+	* @brief 微分を別の超越関数で求めていた以前のカーネル（比較用）
+	*/
+	template<typename T>
+	auto tan(const DualNumbers::dual<T>& d) {
+		using std::cos;
+		using std::tan;
+
+		auto cos_a = cos(d.a());
+		return DualNumbers::dual<T>{tan(d.a()), d.b() / (cos_a*cos_a)};
+	}
+
+	template<typename T>
+	auto tanh(const DualNumbers::dual<T>& d) {
+		using std::tanh;
+		using std::cosh;
+
+		auto cosh_a = cosh(d.a());
+		return DualNumbers::dual<T>{tanh(d.a()), d.b() / (cosh_a*cosh_a)};
+	}
+
+	template<typename T>
+	auto expm1(const DualNumbers::dual<T>& d) {
+		using std::exp;
+		using std::expm1;
+
+		return DualNumbers::dual<T>{expm1(d.a()), d.b()*exp(d.a())};
+	}
+}
+
+/**
+* 1回の評価あたりのハードウェアカウンタの値
+* @detail 数えられなかったイベントはNaN
+*/
+struct counter_values {
+	double cycles = std::numeric_limits<double>::quiet_NaN();
+	double instructions = std::numeric_limits<double>::quiet_NaN();
+	double branch_misses = std::numeric_limits<double>::quiet_NaN();
+	double cache_misses = std::numeric_limits<double>::quiet_NaN();
+
+	/**
+	* 1サイクルあたりの命令数
+	*/
+	double ipc() const {
+		return instructions / cycles;
+	}
+};
+
+/**
+* @brief perf_event_openによるハードウェアカウンタ（Linuxのみ）
+* @detail 4つのイベントを1つのグループにして同時に数える、ユーザー空間の分だけを数えるのでperf_event_paranoidが2以下なら使える
+*         イベントが多重化された場合は有効時間と実行時間の比で補正する
+*         Linux以外や、仮想マシンなどでPMUが使えない場合はavailable()がfalseになる
+*/
+class hardware_counters {
+public:
+	static constexpr std::size_t event_count = 4;
+
+	hardware_counters() {
+#ifdef __linux__
+		const std::uint64_t configs[event_count] = {
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+		};
+
+		for (std::size_t e = 0; e < event_count; ++e) {
+			perf_event_attr attr{};
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = configs[e];
+			attr.disabled = (e == 0) ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			//先頭（サイクル）がグループのリーダー、開けなかったイベントは飛ばす
+			m_fds[e] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, (e == 0) ? -1 : m_fds[0], 0));
+			if (m_fds[e] < 0) {
+				if (e == 0) return;
+				continue;
+			}
+			::ioctl(m_fds[e], PERF_EVENT_IOC_ID, &m_ids[e]);
+		}
+#endif
+	}
+
+	~hardware_counters() {
+#ifdef __linux__
+		for (int fd : m_fds) {
+			if (0 <= fd) ::close(fd);
+		}
+#endif
+	}
+
+	hardware_counters(const hardware_counters&) = delete;
+	hardware_counters& operator=(const hardware_counters&) = delete;
+
+	/**
+	* 少なくともサイクル数は数えられるか
+	*/
+	bool available() const {
+		return 0 <= m_fds[0];
+	}
+
+	/**
+	* 全てのカウンタを0にして数え始める
+	*/
+	void start() {
+#ifdef __linux__
+		if (!available()) return;
+		::ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		::ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+	}
+
+	/**
+	* 数えるのを止めて、start()からの増分をevaluationsで割った値を返す
+	*/
+	counter_values stop(double evaluations) {
+		counter_values values;
+#ifdef __linux__
+		if (!available()) return values;
+		::ioctl(m_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		//{ nr, time_enabled, time_running, { value, id }[nr] }
+		std::uint64_t buffer[3 + 2 * event_count] = {};
+		if (::read(m_fds[0], buffer, sizeof(buffer)) <= 0 || buffer[2] == 0) return values;
+
+		const double scale = double(buffer[1]) / double(buffer[2]) / evaluations;
+		double* fields[event_count] = { &values.cycles, &values.instructions, &values.branch_misses, &values.cache_misses };
+
+		for (std::uint64_t n = 0; n < buffer[0] && n < event_count; ++n) {
+			const std::uint64_t value = buffer[3 + 2 * n];
+			const std::uint64_t id = buffer[4 + 2 * n];
+
+			for (std::size_t e = 0; e < event_count; ++e) {
+				if (0 <= m_fds[e] && m_ids[e] == id) *fields[e] = double(value) * scale;
+			}
+		}
+#else
+		static_cast<void>(evaluations);
+#endif
+		return values;
+	}
+
+private:
+	int m_fds[event_count] = { -1, -1, -1, -1 };
+	std::uint64_t m_ids[event_count] = {};
+};
+
+/**
+* コマンドラインの設定
+*/
+struct options {
+	std::string format = "table";
+	std::string filter;
+
+	/**
+	* --countersが指定され、カウンタを開けた時だけnullptrでない
+	*/
+	hardware_counters* counters = nullptr;
+
+	bool matches(const std::string& group, const std::string& name, const std::string& type) const {
+		return filter.empty() || (group + "/" + name + "/" + type).find(filter) != std::string::npos;
+	}
+};
+
+/**
+* 1回の評価あたりの時間[ns]
+*/
+struct timing {
+
+	/**
+	* 独立な評価を並べた時の時間（スループット）
+	*/
+	double throughput = 0.0;
+
+	/**
+	* 前の結果に依存する評価を連ねた時の時間（レイテンシ）
+	*/
+	double latency = 0.0;
+
+	/**
+	* スループットの計測中に数えたカウンタ
+	*/
+	counter_values counters;
+};
+
+/**
+* 1項目の計測結果
+* @detail baselineは同じ値と微分を双対数を使わずに手で書いた式
+*/
+struct result_row {
+	std::string group;
+	std::string name;
+	std::string type;
+	timing dual;
+	timing baseline;
+};
+
+/**
+* 1回の計測で評価する点の数、L1キャッシュに収まる大きさ
+*/
+constexpr std::size_t input_count = 1024;
+
+/**
+* 1項目あたりの計測時間の目安[ns]
+*/
+constexpr double target_time = 5.0e6;
+
+/**
+* [lo, hi]を等分した点、reversedなら逆順
+*/
+template<typename T>
+std::vector<T> grid(T lo, T hi, bool reversed = false) {
+	std::vector<T> points(input_count);
+	for (std::size_t i = 0; i < input_count; ++i) {
+		const std::size_t k = reversed ? input_count - 1 - i : i;
+		points[i] = lo + (hi - lo) * (T(k) + T(0.5)) / T(input_count);
+	}
+	return points;
+}
+
+/**
+* 結果の実部を取り出す、ハンケル関数などの複素数は実部と虚部の和にする
+*/
+template<typename V>
+auto component(const V& v) {
+	return v;
+}
+
+template<typename V>
+auto component(const std::complex<V>& v) {
+	return v.real() + v.imag();
+}
+
+/**
+* passをinputs回の評価とみなして1回あたりの時間を測る
+* @detail 1回目の実行で繰り返し回数を決め、計測時間がtarget_time程度になるようにする
+* @param counters nullptrでなければ、繰り返しの間のカウンタの値を1回の評価あたりにしてeventsに書き込む
+*/
+template<typename Pass>
+double timed(Pass pass, hardware_counters* counters = nullptr, counter_values* events = nullptr) {
+	using clock = std::chrono::steady_clock;
+
+	auto start = clock::now();
+	pass();
+	const std::chrono::duration<double, std::nano> once = clock::now() - start;
+	const std::size_t repeat = std::max<std::size_t>(3, static_cast<std::size_t>(target_time / std::max(once.count(), 1.0)));
+
+	if (counters != nullptr) counters->start();
+	start = clock::now();
+	for (std::size_t r = 0; r < repeat; ++r) pass();
+	const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+	if (counters != nullptr) *events = counters->stop(double(repeat * input_count));
+
+	return elapsed.count() / double(repeat * input_count);
+}
+
+/**
+* スループット[ns]
+* @detail 結果は配列に書き出すので、各評価は独立でありループはベクトル化されうる
+* @param f (dual<T> x, dual<T> y)を受ける関数、単項の関数はyを無視する
+* @param counters, events timed()を参照
+*/
+template<typename T, typename Func>
+double measure_throughput(const std::vector<T>& xs, const std::vector<T>& ys, Func f, hardware_counters* counters = nullptr, counter_values* events = nullptr) {
+	using DualNumbers::dual;
+
+	std::vector<T> a(input_count);
+	std::vector<T> b(input_count);
+	const T* px = xs.data();
+	const T* py = ys.data();
+	T* pa = a.data();
+	T* pb = b.data();
+
+	volatile T sink = T(0.0);
+	std::size_t round = 0;
+
+	return timed([&] {
+		for (std::size_t i = 0; i < input_count; ++i) {
+			const auto d = f(dual<T>{ px[i], T(1.0) }, dual<T>{ py[i], T(0.5) });
+			pa[i] = static_cast<T>(component(d.a()));
+			pb[i] = static_cast<T>(component(d.b()));
+		}
+		++round;
+		sink = sink + pa[round % input_count] + pb[round % input_count];
+	}, counters, events);
+}
+
+/**
+* レイテンシ[ns]
+* @detail 前の結果（実部と虚部の和）に0を掛けて次の入力に足すことで、値を変えずに評価を直列にする
+*         0は最適化で消されないようにvolatileから読む、つなぎの加算2回と乗算1回の分だけ実際のレイテンシより長くなる
+*/
+template<typename T, typename Func>
+double measure_latency(const std::vector<T>& xs, const std::vector<T>& ys, Func f) {
+	using DualNumbers::dual;
+
+	volatile T zero_source = T(0.0);
+	const T zero = zero_source;
+	const T* px = xs.data();
+	const T* py = ys.data();
+
+	T carry = T(0.0);
+	volatile T sink = T(0.0);
+
+	return timed([&] {
+		for (std::size_t i = 0; i < input_count; ++i) {
+			const auto d = f(dual<T>{ px[i] + zero * carry, T(1.0) }, dual<T>{ py[i], T(0.5) });
+			carry = static_cast<T>(component(d.a())) + static_cast<T>(component(d.b()));
+		}
+		sink = carry;
+	});
+}
+
+#if 201603L <= __cpp_lib_math_special_functions
+
+/**
+* @brief 値型に合わせて接尾辞付き（f、l）の特殊関数を選ぶ
+*/
+template<typename T>
+struct special;
+
+template<>
+struct special<float> {
+	template<typename X> static auto j(float nu, const X& x) { return DualNumbers::cyl_bessel_jf(nu, x); }
+	template<typename X> static auto y(float nu, const X& x) { return DualNumbers::cyl_neumannf(nu, x); }
+	template<typename X> static auto i(float nu, const X& x) { return DualNumbers::cyl_bessel_if(nu, x); }
+	template<typename X> static auto k(float nu, const X& x) { return DualNumbers::cyl_bessel_kf(nu, x); }
+	template<typename X> static auto h1(float nu, const X& x) { return DualNumbers::cyl_hankel_1f(nu, x); }
+};
+
+template<>
+struct special<double> {
+	template<typename X> static auto j(double nu, const X& x) { return DualNumbers::cyl_bessel_j(nu, x); }
+	template<typename X> static auto y(double nu, const X& x) { return DualNumbers::cyl_neumann(nu, x); }
+	template<typename X> static auto i(double nu, const X& x) { return DualNumbers::cyl_bessel_i(nu, x); }
+	template<typename X> static auto k(double nu, const X& x) { return DualNumbers::cyl_bessel_k(nu, x); }
+	template<typename X> static auto h1(double nu, const X& x) { return DualNumbers::cyl_hankel_1(nu, x); }
+};
+
+template<>
+struct special<long double> {
+	template<typename X> static auto j(long double nu, const X& x) { return DualNumbers::cyl_bessel_jl(nu, x); }
+	template<typename X> static auto y(long double nu, const X& x) { return DualNumbers::cyl_neumannl(nu, x); }
+	template<typename X> static auto i(long double nu, const X& x) { return DualNumbers::cyl_bessel_il(nu, x); }
+	template<typename X> static auto k(long double nu, const X& x) { return DualNumbers::cyl_bessel_kl(nu, x); }
+	template<typename X> static auto h1(long double nu, const X& x) { return DualNumbers::cyl_hankel_1l(nu, x); }
+};
+
+#endif
+
+/**
+* 型毎に全ての演算子とcmath関数を計測する
+* @param type 出力に使う型名
+*/
+template<typename T>
+void run_suite(const std::string& type, const options& opts, std::vector<result_row>& rows) {
+	using namespace DualNumbers;
+	using D = dual<T>;
+
+	auto bench = [&](const std::string& group, const std::string& name, T lo, T hi, T y_lo, T y_hi, auto f, auto baseline) {
+		if (!opts.matches(group, name, type)) return;
+
+		const auto xs = grid(lo, hi);
+		const auto ys = grid(y_lo, y_hi, true);
+
+		result_row row{ group, name, type, {}, {} };
+		row.dual.throughput = measure_throughput(xs, ys, f, opts.counters, &row.dual.counters);
+		row.dual.latency = measure_latency(xs, ys, f);
+		row.baseline.throughput = measure_throughput(xs, ys, baseline, opts.counters, &row.baseline.counters);
+		row.baseline.latency = measure_latency(xs, ys, baseline);
+		rows.push_back(row);
+	};
+
+	auto unary = [&](const std::string& group, const std::string& name, T lo, T hi, auto f, auto baseline) {
+		bench(group, name, lo, hi, T(0.5), T(2.0), f, baseline);
+	};
+
+	//演算子
+	bench("operator", "x+y", T(-4.0), T(4.0), T(-4.0), T(4.0),
+		[](const D& x, const D& y) { return x + y; },
+		[](const D& x, const D& y) { return D{ x.a() + y.a(), x.b() + y.b() }; });
+	bench("operator", "x-y", T(-4.0), T(4.0), T(-4.0), T(4.0),
+		[](const D& x, const D& y) { return x - y; },
+		[](const D& x, const D& y) { return D{ x.a() - y.a(), x.b() - y.b() }; });
+	bench("operator", "x*y", T(-4.0), T(4.0), T(-4.0), T(4.0),
+		[](const D& x, const D& y) { return x * y; },
+		[](const D& x, const D& y) { return D{ x.a() * y.a(), x.a() * y.b() + x.b() * y.a() }; });
+	bench("operator", "x/y", T(-4.0), T(4.0), T(0.5), T(4.0),
+		[](const D& x, const D& y) { return x / y; },
+		[](const D& x, const D& y) { return D{ x.a() / y.a(), (x.b() * y.a() - x.a() * y.b()) / (y.a() * y.a()) }; });
+	unary("operator", "-x", T(-4.0), T(4.0),
+		[](const D& x, const D&) { return -x; },
+		[](const D& x, const D&) { return D{ -x.a(), -x.b() }; });
+	bench("operator", "x+s", T(-4.0), T(4.0), T(-4.0), T(4.0),
+		[](const D& x, const D& y) { return x + y.a(); },
+		[](const D& x, const D& y) { return D{ x.a() + y.a(), x.b() }; });
+	bench("operator", "x*s", T(-4.0), T(4.0), T(-4.0), T(4.0),
+		[](const D& x, const D& y) { return x * y.a(); },
+		[](const D& x, const D& y) { return D{ x.a() * y.a(), x.b() * y.a() }; });
+	bench("operator", "x/s", T(-4.0), T(4.0), T(0.5), T(4.0),
+		[](const D& x, const D& y) { return x / y.a(); },
+		[](const D& x, const D& y) { return D{ x.a() / y.a(), x.b() / y.a() }; });
+	bench("operator", "s/x", T(0.5), T(4.0), T(-4.0), T(4.0),
+		[](const D& x, const D& y) { return y.a() / x; },
+		[](const D& x, const D& y) { return D{ y.a() / x.a(), -y.a() * x.b() / (x.a() * x.a()) }; });
+	unary("operator", "inverted", T(0.5), T(4.0),
+		[](const D& x, const D&) { return x.inverted(); },
+		[](const D& x, const D&) { return D{ T(1.0) / x.a(), -x.b() / (x.a() * x.a()) }; });
+
+	//cmath
+	unary("cmath", "sqrt", T(0.1), T(10.0),
+		[](const D& x, const D&) { return sqrt(x); },
+		[](const D& x, const D&) { using std::sqrt; return D{ sqrt(x.a()), x.b() / (T(2.0) * sqrt(x.a())) }; });
+	unary("cmath", "cbrt", T(0.1), T(10.0),
+		[](const D& x, const D&) { return cbrt(x); },
+		[](const D& x, const D&) { using std::cbrt; return D{ cbrt(x.a()), x.b() / (T(3.0) * cbrt(x.a()) * cbrt(x.a())) }; });
+	unary("cmath", "sin", T(-4.0), T(4.0),
+		[](const D& x, const D&) { return sin(x); },
+		[](const D& x, const D&) { using std::sin; using std::cos; return D{ sin(x.a()), x.b() * cos(x.a()) }; });
+	unary("cmath", "cos", T(-4.0), T(4.0),
+		[](const D& x, const D&) { return cos(x); },
+		[](const D& x, const D&) { using std::sin; using std::cos; return D{ cos(x.a()), -x.b() * sin(x.a()) }; });
+	unary("cmath", "sincos", T(-4.0), T(4.0),
+		[](const D& x, const D&) { const auto sc = sincos(x); return sc.first + sc.second; },
+		[](const D& x, const D&) { using std::sin; using std::cos; const T s = sin(x.a()); const T c = cos(x.a()); return D{ s + c, x.b() * (c - s) }; });
+	unary("cmath", "tan", T(-1.5), T(1.5),
+		[](const D& x, const D&) { return tan(x); },
+		[](const D& x, const D&) { using std::tan; using std::cos; return D{ tan(x.a()), x.b() / (cos(x.a()) * cos(x.a())) }; });
+	unary("cmath", "asin", T(-0.9), T(0.9),
+		[](const D& x, const D&) { return asin(x); },
+		[](const D& x, const D&) { using std::asin; using std::sqrt; return D{ asin(x.a()), x.b() / sqrt(T(1.0) - x.a() * x.a()) }; });
+	unary("cmath", "acos", T(-0.9), T(0.9),
+		[](const D& x, const D&) { return acos(x); },
+		[](const D& x, const D&) { using std::acos; using std::sqrt; return D{ acos(x.a()), -x.b() / sqrt(T(1.0) - x.a() * x.a()) }; });
+	unary("cmath", "atan", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return atan(x); },
+		[](const D& x, const D&) { using std::atan; return D{ atan(x.a()), x.b() / (T(1.0) + x.a() * x.a()) }; });
+	unary("cmath", "sinh", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return sinh(x); },
+		[](const D& x, const D&) { using std::sinh; using std::cosh; return D{ sinh(x.a()), x.b() * cosh(x.a()) }; });
+	unary("cmath", "cosh", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return cosh(x); },
+		[](const D& x, const D&) { using std::sinh; using std::cosh; return D{ cosh(x.a()), x.b() * sinh(x.a()) }; });
+	unary("cmath", "tanh", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return tanh(x); },
+		[](const D& x, const D&) { using std::tanh; using std::cosh; return D{ tanh(x.a()), x.b() / (cosh(x.a()) * cosh(x.a())) }; });
+	unary("cmath", "asinh", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return asinh(x); },
+		[](const D& x, const D&) { using std::asinh; using std::sqrt; return D{ asinh(x.a()), x.b() / sqrt(x.a() * x.a() + T(1.0)) }; });
+	unary("cmath", "acosh", T(1.1), T(10.0),
+		[](const D& x, const D&) { return acosh(x); },
+		[](const D& x, const D&) { using std::acosh; using std::sqrt; return D{ acosh(x.a()), x.b() / sqrt(x.a() * x.a() - T(1.0)) }; });
+	unary("cmath", "atanh", T(-0.9), T(0.9),
+		[](const D& x, const D&) { return atanh(x); },
+		[](const D& x, const D&) { using std::atanh; return D{ atanh(x.a()), x.b() / (T(1.0) - x.a() * x.a()) }; });
+	unary("cmath", "exp", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return exp(x); },
+		[](const D& x, const D&) { using std::exp; return D{ exp(x.a()), x.b() * exp(x.a()) }; });
+	unary("cmath", "exp2", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return exp2(x); },
+		[](const D& x, const D&) { using std::exp2; using std::log; return D{ exp2(x.a()), x.b() * exp2(x.a()) * log(T(2.0)) }; });
+	unary("cmath", "expm1", T(-5.0), T(5.0),
+		[](const D& x, const D&) { return expm1(x); },
+		[](const D& x, const D&) { using std::expm1; using std::exp; return D{ expm1(x.a()), x.b() * exp(x.a()) }; });
+	unary("cmath", "log", T(0.1), T(10.0),
+		[](const D& x, const D&) { return log(x); },
+		[](const D& x, const D&) { using std::log; return D{ log(x.a()), x.b() / x.a() }; });
+	unary("cmath", "log1p", T(-0.5), T(10.0),
+		[](const D& x, const D&) { return log1p(x); },
+		[](const D& x, const D&) { using std::log1p; return D{ log1p(x.a()), x.b() / (T(1.0) + x.a()) }; });
+	unary("cmath", "log10", T(0.1), T(10.0),
+		[](const D& x, const D&) { return log10(x); },
+		[](const D& x, const D&) { using std::log10; using std::log; return D{ log10(x.a()), x.b() / (x.a() * log(T(10.0))) }; });
+	unary("cmath", "log2", T(0.1), T(10.0),
+		[](const D& x, const D&) { return log2(x); },
+		[](const D& x, const D&) { using std::log2; using std::log; return D{ log2(x.a()), x.b() / (x.a() * log(T(2.0))) }; });
+	bench("cmath", "pow(x,y)", T(0.5), T(2.0), T(0.5), T(2.0),
+		[](const D& x, const D& y) { return pow(x, y); },
+		[](const D& x, const D& y) { using std::pow; using std::log; const T p = pow(x.a(), y.a()); return D{ p, p * (y.a() * x.b() / x.a() + y.b() * log(x.a())) }; });
+	bench("cmath", "pow(x,s)", T(0.5), T(2.0), T(0.5), T(2.0),
+		[](const D& x, const D& y) { return pow(x, y.a()); },
+		[](const D& x, const D& y) { using std::pow; return D{ pow(x.a(), y.a()), y.a() * x.b() * pow(x.a(), y.a() - T(1.0)) }; });
+	unary("cmath", "pow(x,3)", T(0.5), T(2.0),
+		[](const D& x, const D&) { return pow(x, 3); },
+		[](const D& x, const D&) { const T x2 = x.a() * x.a(); return D{ x2 * x.a(), T(3.0) * x.b() * x2 }; });
+	unary("cmath", "pow(x,-2)", T(0.5), T(2.0),
+		[](const D& x, const D&) { return pow(x, -2); },
+		[](const D& x, const D&) { const T r = T(1.0) / x.a(); const T r2 = r * r; return D{ r2, T(-2.0) * x.b() * r2 * r }; });
+	bench("cmath", "pow(s,x)", T(-2.0), T(2.0), T(0.5), T(2.0),
+		[](const D& x, const D& y) { return pow(y.a(), x); },
+		[](const D& x, const D& y) { using std::pow; using std::log; const T p = pow(y.a(), x.a()); return D{ p, x.b() * p * log(y.a()) }; });
+	bench("cmath", "atan2", T(-5.0), T(5.0), T(-5.0), T(5.0),
+		[](const D& x, const D& y) { return atan2(x, y); },
+		[](const D& x, const D& y) { using std::atan2; return D{ atan2(x.a(), y.a()), (y.a() * x.b() - x.a() * y.b()) / (x.a() * x.a() + y.a() * y.a()) }; });
+	bench("cmath", "hypot", T(-5.0), T(5.0), T(-5.0), T(5.0),
+		[](const D& x, const D& y) { return hypot(x, y); },
+		[](const D& x, const D& y) { using std::hypot; const T h = hypot(x.a(), y.a()); return D{ h, (x.a() * x.b() + y.a() * y.b()) / h }; });
+	unary("cmath", "polyval", T(-2.0), T(2.0),
+		[](const D& x, const D&) { return polyval({ T(4.0), T(3.0), T(2.0), T(1.0) }, x); },
+		[](const D& x, const D&) { const T a = x.a(); return D{ ((T(4.0) * a + T(3.0)) * a + T(2.0)) * a + T(1.0), x.b() * ((T(12.0) * a + T(6.0)) * a + T(2.0)) }; });
+
+#if 201603L <= __cpp_lib_math_special_functions
+	//特殊関数、微分は隣の次数から求める
+	constexpr T nu = T(1.5);
+
+	unary("special", "cyl_bessel_j", T(0.5), T(10.0),
+		[](const D& x, const D&) { return special<T>::j(nu, x); },
+		[](const D& x, const D&) { using std::cyl_bessel_j; return D{ cyl_bessel_j(nu, x.a()), x.b() * T(0.5) * (cyl_bessel_j(nu - T(1.0), x.a()) - cyl_bessel_j(nu + T(1.0), x.a())) }; });
+	unary("special", "cyl_neumann", T(0.5), T(10.0),
+		[](const D& x, const D&) { return special<T>::y(nu, x); },
+		[](const D& x, const D&) { using std::cyl_neumann; return D{ cyl_neumann(nu, x.a()), x.b() * T(0.5) * (cyl_neumann(nu - T(1.0), x.a()) - cyl_neumann(nu + T(1.0), x.a())) }; });
+	unary("special", "cyl_bessel_i", T(0.5), T(10.0),
+		[](const D& x, const D&) { return special<T>::i(nu, x); },
+		[](const D& x, const D&) { using std::cyl_bessel_i; return D{ cyl_bessel_i(nu, x.a()), x.b() * T(0.5) * (cyl_bessel_i(nu - T(1.0), x.a()) + cyl_bessel_i(nu + T(1.0), x.a())) }; });
+	unary("special", "cyl_bessel_k", T(0.5), T(10.0),
+		[](const D& x, const D&) { return special<T>::k(nu, x); },
+		[](const D& x, const D&) { using std::cyl_bessel_k; return D{ cyl_bessel_k(nu, x.a()), -x.b() * T(0.5) * (cyl_bessel_k(nu - T(1.0), x.a()) + cyl_bessel_k(nu + T(1.0), x.a())) }; });
+	unary("special", "cyl_hankel_1", T(0.5), T(10.0),
+		[](const D& x, const D&) { return special<T>::h1(nu, x); },
+		[](const D& x, const D&) {
+			using std::cyl_bessel_j;
+			using std::cyl_neumann;
+			const T j = cyl_bessel_j(nu, x.a());
+			const T y = cyl_neumann(nu, x.a());
+			const T dj = T(0.5) * (cyl_bessel_j(nu - T(1.0), x.a()) - cyl_bessel_j(nu + T(1.0), x.a()));
+			const T dy = T(0.5) * (cyl_neumann(nu - T(1.0), x.a()) - cyl_neumann(nu + T(1.0), x.a()));
+			return D{ j + y, x.b() * (dj + dy) };
+		});
+#endif
+
+	//高速版（floatとdoubleのみ）
+	if constexpr (std::is_same<T, float>::value || std::is_same<T, double>::value) {
+		unary("fast", "exp", T(-5.0), T(5.0),
+			[](const D& x, const D&) { return fast::exp(x); },
+			[](const D& x, const D&) { using std::exp; return D{ exp(x.a()), x.b() * exp(x.a()) }; });
+		unary("fast", "log", T(0.1), T(10.0),
+			[](const D& x, const D&) { return fast::log(x); },
+			[](const D& x, const D&) { using std::log; return D{ log(x.a()), x.b() / x.a() }; });
+		unary("fast", "sin", T(-4.0), T(4.0),
+			[](const D& x, const D&) { return fast::sin(x); },
+			[](const D& x, const D&) { using std::sin; using std::cos; return D{ sin(x.a()), x.b() * cos(x.a()) }; });
+		unary("fast", "cos", T(-4.0), T(4.0),
+			[](const D& x, const D&) { return fast::cos(x); },
+			[](const D& x, const D&) { using std::sin; using std::cos; return D{ cos(x.a()), -x.b() * sin(x.a()) }; });
+	}
+}
+
+/**
+* JSON文字列として出力できるようにエスケープする
+*/
+std::string escape(const std::string& s) {
+	std::string escaped;
+	for (char c : s) {
+		if (c == '"' || c == '\\') escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+/**
+* カウンタの値を出力する、数えられなかった値はmissingを出力する
+*/
+void print_count(double value, const char* missing) {
+	if (std::isnan(value)) {
+		std::cout << missing;
+	} else {
+		std::cout << value;
+	}
+}
+
+/**
+* @param counters trueならdualのカウンタの値（1回あたり）の列も出力する
+*/
+void print_table(const std::vector<result_row>& rows, bool counters) {
+	std::cout << std::left << std::setw(10) << "group" << std::setw(14) << "name" << std::setw(9) << "type" << std::right
+		<< std::setw(12) << "thru[ns]" << std::setw(12) << "lat[ns]"
+		<< std::setw(12) << "base thru" << std::setw(12) << "base lat" << std::setw(10) << "ratio";
+	if (counters) {
+		std::cout << std::setw(10) << "cycles" << std::setw(10) << "insns" << std::setw(8) << "IPC"
+			<< std::setw(10) << "br-miss" << std::setw(10) << "$-miss" << std::setw(10) << "base IPC";
+	}
+	std::cout << std::endl;
+
+	for (const auto& row : rows) {
+		std::cout << std::left << std::setw(10) << row.group << std::setw(14) << row.name << std::setw(9) << row.type << std::right
+			<< std::fixed << std::setprecision(2)
+			<< std::setw(12) << row.dual.throughput << std::setw(12) << row.dual.latency
+			<< std::setw(12) << row.baseline.throughput << std::setw(12) << row.baseline.latency
+			<< std::setw(10) << row.dual.throughput / row.baseline.throughput;
+		if (counters) {
+			const auto& c = row.dual.counters;
+			std::cout << std::setw(10) << c.cycles << std::setw(10) << c.instructions << std::setw(8) << c.ipc()
+				<< std::setprecision(4) << std::setw(10) << c.branch_misses << std::setw(10) << c.cache_misses
+				<< std::setprecision(2) << std::setw(10) << row.baseline.counters.ipc();
+		}
+		std::cout << std::endl;
+	}
+
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << std::setprecision(6);
+}
+
+void print_csv(const std::vector<result_row>& rows, bool counters) {
+	std::cout << "group,name,type,throughput_ns,latency_ns,baseline_throughput_ns,baseline_latency_ns";
+	if (counters) {
+		for (const char* prefix : { "", "baseline_" }) {
+			std::cout << "," << prefix << "cycles," << prefix << "instructions," << prefix << "ipc,"
+				<< prefix << "branch_misses," << prefix << "cache_misses";
+		}
+	}
+	std::cout << std::endl;
+
+	for (const auto& row : rows) {
+		std::cout << row.group << ",\"" << row.name << "\"," << row.type << ","
+			<< row.dual.throughput << "," << row.dual.latency << ","
+			<< row.baseline.throughput << "," << row.baseline.latency;
+		if (counters) {
+			for (const auto* c : { &row.dual.counters, &row.baseline.counters }) {
+				for (double value : { c->cycles, c->instructions, c->ipc(), c->branch_misses, c->cache_misses }) {
+					std::cout << ",";
+					print_count(value, "");
+				}
+			}
+		}
+		std::cout << std::endl;
+	}
+}
+
+/**
+* JSONのオブジェクトとしてカウンタの値を出力する、数えられなかった値はnull
+*/
+void print_json_counters(const counter_values& c) {
+	std::cout << "{\"cycles\": ";
+	print_count(c.cycles, "null");
+	std::cout << ", \"instructions\": ";
+	print_count(c.instructions, "null");
+	std::cout << ", \"ipc\": ";
+	print_count(c.ipc(), "null");
+	std::cout << ", \"branch_misses\": ";
+	print_count(c.branch_misses, "null");
+	std::cout << ", \"cache_misses\": ";
+	print_count(c.cache_misses, "null");
+	std::cout << "}";
+}
+
+void print_json(const std::vector<result_row>& rows, bool counters) {
+	std::cout << "{\n  \"unit\": \"ns/op\",\n  \"results\": [";
+
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		const auto& row = rows[i];
+		std::cout << ((i == 0) ? "\n" : ",\n")
+			<< "    {\"group\": \"" << escape(row.group) << "\", \"name\": \"" << escape(row.name) << "\", \"type\": \"" << row.type << "\""
+			<< ", \"throughput\": " << row.dual.throughput << ", \"latency\": " << row.dual.latency
+			<< ", \"baseline_throughput\": " << row.baseline.throughput << ", \"baseline_latency\": " << row.baseline.latency;
+		if (counters) {
+			std::cout << ", \"counters\": ";
+			print_json_counters(row.dual.counters);
+			std::cout << ", \"baseline_counters\": ";
+			print_json_counters(row.baseline.counters);
+		}
+		std::cout << "}";
+	}
+
+	std::cout << "\n  ]\n}" << std::endl;
+}
+
+/**
+* 1回の評価あたりの数学関数の呼び出し回数
+*/
+template<typename Func>
+std::size_t count_calls(Func f) {
+	using counting::counted;
+
+	counted::calls = 0;
+	f(DualNumbers::dual<counted>{ counted{ 0.5 }, counted{ 1.0 } });
+	return counted::calls;
+}
+
+/**
+* 以前のカーネルと現在のカーネルの呼び出し回数と時間を比べる
+*/
+template<typename Reference, typename Current>
+void compare(const std::string& name, double lo, double hi, Reference reference, Current current) {
+	const auto inputs = grid(lo, hi);
+	auto unary = [](auto f) { return [f](const auto& x, const auto&) { return f(x); }; };
+
+	std::cout << std::left << std::setw(8) << name << std::right
+		<< std::setw(6) << count_calls(reference) << std::setw(6) << count_calls(current)
+		<< std::fixed << std::setprecision(2)
+		<< std::setw(12) << measure_throughput(inputs, inputs, unary(reference))
+		<< std::setw(12) << measure_throughput(inputs, inputs, unary(current)) << std::endl;
+
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << std::setprecision(6);
+}
+
+/**
+* 2つのdoubleの間にある表現可能な値の数
+*/
+std::uint64_t ulp_distance(double x, double y) {
+	if (x == y) return 0;
+	if (std::isnan(x) || std::isnan(y)) return UINT64_MAX;
+
+	auto ordered = [](double v) {
+		std::int64_t bits;
+		std::memcpy(&bits, &v, sizeof(bits));
+		return (bits < 0) ? INT64_MIN - bits : bits;
+	};
+
+	const std::int64_t a = ordered(x);
+	const std::int64_t b = ordered(y);
+	return (a < b) ? std::uint64_t(b) - std::uint64_t(a) : std::uint64_t(a) - std::uint64_t(b);
+}
+
+/**
+* 高速版の値と微分の、std版に対する最大誤差[ULP]と時間を比べる
+* @param lo, hi 評価する区間
+*/
+template<typename Fast, typename Reference>
+void accuracy(const std::string& name, double lo, double hi, Fast fast, Reference reference) {
+	constexpr std::size_t samples = 1000000;
+
+	std::uint64_t value_ulp = 0;
+	std::uint64_t derivative_ulp = 0;
+
+	for (std::size_t i = 0; i < samples; ++i) {
+		const double x = lo + (hi - lo) * (double(i) + 0.5) / double(samples);
+		const auto f = fast(DualNumbers::dual<double>{ x, 1.0 });
+		const auto g = reference(DualNumbers::dual<double>{ x, 1.0 });
+
+		value_ulp = std::max(value_ulp, ulp_distance(f.a(), g.a()));
+		derivative_ulp = std::max(derivative_ulp, ulp_distance(f.b(), g.b()));
+	}
+
+	const auto inputs = grid(lo, hi);
+	auto unary = [](auto f) { return [f](const auto& x, const auto&) { return f(x); }; };
+
+	std::cout << std::left << std::setw(8) << name << std::right
+		<< std::setw(10) << lo << std::setw(10) << hi
+		<< std::setw(8) << value_ulp << std::setw(8) << derivative_ulp
+		<< std::fixed << std::setprecision(2)
+		<< std::setw(12) << measure_throughput(inputs, inputs, unary(reference))
+		<< std::setw(12) << measure_throughput(inputs, inputs, unary(fast)) << std::endl;
+
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << std::setprecision(6);
+}
+
+/**
+* pow(dual, dual)の値と偏微分の最大誤差[ULP]
+* @detail 参照値はlong doubleで求めたpowl、logl、比較としてdoubleのstd::pow、std::logで偏微分の式をそのまま計算した値の誤差も出す
+*         long doubleがdoubleと同じ精度の環境では参照値自体の誤差が含まれる
+* @param x_lo, x_hi 底の区間
+* @param y_lo, y_hi 指数の区間
+*/
+void pow_accuracy(double x_lo, double x_hi, double y_lo, double y_hi) {
+	using DualNumbers::dual;
+	constexpr std::size_t steps = 1000;
+
+	std::uint64_t kernel_ulp[3] = {};
+	std::uint64_t formula_ulp[3] = {};
+
+	for (std::size_t i = 0; i < steps; ++i) {
+		for (std::size_t j = 0; j < steps; ++j) {
+			const double x = x_lo + (x_hi - x_lo) * (double(i) + 0.5) / double(steps);
+			const double y = y_lo + (y_hi - y_lo) * (double(j) + 0.5) / double(steps);
+
+			const long double value = std::pow((long double)x, (long double)y);
+			const double reference[3] = {
+				double(value), double((long double)y * std::pow((long double)x, (long double)y - 1.0L)), double(value * std::log((long double)x))
+			};
+
+			//両方の微分が0でない時の偏微分と、片方の微分が0の時の高速パスの悪い方
+			const auto partials = DualNumbers::Detail::pow_partials(x, y);
+			const auto df = pow(dual<double>{ x, 1.0 }, dual<double>{ y, 0.0 });
+			const auto dy = pow(dual<double>{ x, 0.0 }, dual<double>{ y, 1.0 });
+			const double general[3] = { partials[0], partials[1], partials[2] };
+			const double fast_path[3] = { df.a(), df.b(), dy.b() };
+
+			const double p = std::pow(x, y);
+			const double formula[3] = { p, y * std::pow(x, y - 1.0), p * std::log(x) };
+
+			for (std::size_t k = 0; k < 3; ++k) {
+				kernel_ulp[k] = std::max({ kernel_ulp[k], ulp_distance(general[k], reference[k]), ulp_distance(fast_path[k], reference[k]) });
+				formula_ulp[k] = std::max(formula_ulp[k], ulp_distance(formula[k], reference[k]));
+			}
+		}
+	}
+
+	std::cout << std::setw(10) << x_lo << std::setw(10) << x_hi << std::setw(8) << y_lo << std::setw(8) << y_hi;
+	for (std::size_t k = 0; k < 3; ++k) {
+		std::cout << std::setw(6) << kernel_ulp[k] << "/" << std::left << std::setw(4) << formula_ulp[k] << std::right;
+	}
+	std::cout << std::endl;
+}
+
+/**
+* 以前のカーネルとの比較と高速版の精度、table形式で全項目を計測する時だけ出力する
+*/
+void print_kernel_reports() {
+	using namespace DualNumbers;
+
+	std::cout << std::endl;
+	std::cout << "function  calls(before/after)  ns/op(before/after)" << std::endl;
+
+	compare("tan",   -1.5, 1.5, [](const auto& d) { return reference::tan(d); },   [](const auto& d) { return tan(d); });
+	compare("tanh",  -5.0, 5.0, [](const auto& d) { return reference::tanh(d); },  [](const auto& d) { return tanh(d); });
+	compare("expm1", -5.0, 5.0, [](const auto& d) { return reference::expm1(d); }, [](const auto& d) { return expm1(d); });
+
+	std::cout << std::endl;
+	std::cout << "fast      lo        hi        ulp(value/derivative)  ns/op(std/fast)" << std::endl;
+
+	accuracy("exp", -708.0, 709.0, [](const auto& d) { return fast::exp(d); }, [](const auto& d) { return exp(d); });
+	accuracy("exp", -1.0, 1.0, [](const auto& d) { return fast::exp(d); }, [](const auto& d) { return exp(d); });
+	accuracy("log", 1.0e-300, 1.0e300, [](const auto& d) { return fast::log(d); }, [](const auto& d) { return log(d); });
+	accuracy("log", 0.5, 2.0, [](const auto& d) { return fast::log(d); }, [](const auto& d) { return log(d); });
+	accuracy("sin", -1.0e5, 1.0e5, [](const auto& d) { return fast::sin(d); }, [](const auto& d) { return sin(d); });
+	accuracy("sin", -4.0, 4.0, [](const auto& d) { return fast::sin(d); }, [](const auto& d) { return sin(d); });
+	accuracy("cos", -1.0e5, 1.0e5, [](const auto& d) { return fast::cos(d); }, [](const auto& d) { return cos(d); });
+	accuracy("cos", -4.0, 4.0, [](const auto& d) { return fast::cos(d); }, [](const auto& d) { return cos(d); });
+
+	std::cout << std::endl;
+	std::cout << "pow(dual, dual) ulp(kernel/std formula)" << std::endl;
+	std::cout << std::setw(10) << "x lo" << std::setw(10) << "x hi" << std::setw(8) << "y lo" << std::setw(8) << "y hi"
+		<< std::setw(11) << "value" << std::setw(11) << "d/dx" << std::setw(11) << "d/dy" << std::endl;
+	if (std::numeric_limits<long double>::digits <= std::numeric_limits<double>::digits) {
+		std::cout << "(long double is not wider than double, the reference is not exact)" << std::endl;
+	}
+
+	pow_accuracy(0.5, 2.0, -4.0, 4.0);
+	pow_accuracy(1.0e-3, 1.0e3, -20.0, 20.0);
+	pow_accuracy(1.0e-100, 1.0e100, -3.0, 3.0);
+}
+
+int main(int argc, char* argv[])
+{
+	options opts;
+	bool use_counters = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+
+		if (arg.rfind("--format=", 0) == 0) {
+			opts.format = arg.substr(9);
+		} else if (arg.rfind("--filter=", 0) == 0) {
+			opts.filter = arg.substr(9);
+		} else if (arg == "--counters") {
+			use_counters = true;
+		} else {
+			std::cerr << "usage: Benchmark [--format=table|csv|json] [--filter=group/name/type] [--counters]" << std::endl;
+			return 1;
+		}
+	}
+
+	if (opts.format != "table" && opts.format != "csv" && opts.format != "json") {
+		std::cerr << "unknown format: " << opts.format << std::endl;
+		return 1;
+	}
+
+	//カウンタが使えなくても時間の計測は続ける
+	hardware_counters counters;
+	if (use_counters) {
+		if (counters.available()) {
+			opts.counters = &counters;
+		} else {
+			std::cerr << "hardware counters are not available (perf_event_open failed), measuring time only" << std::endl;
+		}
+	}
+	const bool report_counters = opts.counters != nullptr;
+
+	std::vector<result_row> rows;
+	run_suite<float>("dual_f", opts, rows);
+	run_suite<double>("dual_d", opts, rows);
+	run_suite<long double>("dual_ld", opts, rows);
+
+	if (opts.format == "csv") {
+		print_csv(rows, report_counters);
+	} else if (opts.format == "json") {
+		print_json(rows, report_counters);
+	} else {
+		print_table(rows, report_counters);
+		if (opts.filter.empty()) print_kernel_reports();
+	}
+}
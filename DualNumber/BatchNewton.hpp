@@ -0,0 +1,159 @@
+﻿#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DualNumber.hpp"
+#include "SimdPack.hpp"
+#include "ThreadPool.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief バッチニュートン法の設定
+	* @tparam T 値型
+	*/
+	template<typename T>
+	struct newton_options {
+
+		/**
+		* 収束判定の閾値、更新量が tolerance * max(1, |x|) 以下になったら収束とする
+		*/
+		T tolerance = T(4.0) * std::numeric_limits<T>::epsilon();
+
+		/**
+		* 1問題あたりの最大反復回数
+		*/
+		std::size_t max_iterations = 100;
+	};
+
+	/**
+	* @brief 独立な多数の求根問題をSIMDレーンで並べてニュートン法で解く
+	* @detail 1レーンが1問題を担当し、dual<pack<T, W>>で全レーンの値と微分を同時に評価する
+	*         収束したレーンにはすぐに次の問題を詰め直すので、反復回数の多い問題があっても他のレーンは止まらない
+	*         結果はレーン数によらず問題毎に逐次のニュートン法と同じ反復で得られる
+	* @tparam W レーン数
+	* @param x0 count個の初期値
+	* @param params P個のパラメータ配列（SoA、それぞれcount個）
+	* @param count 問題の数
+	* @param f (const dual<pack<T, W>>& x, const std::array<pack<T, W>, P>& params)を受けて dual<pack<T, W>> を返す関数
+	* @param roots count個の解を書き込む領域
+	* @param iterations count個の反復回数を書き込む領域、nullptrなら書き込まない
+	* @param options 収束判定の設定
+	* @return 最大反復回数までに収束しなかった問題の数
+	*/
+	template<std::size_t W, typename T, std::size_t P, typename Func>
+	std::size_t newton_batch(const T* x0, const std::array<const T*, P>& params, std::size_t count, Func&& f, T* roots, std::size_t* iterations, const newton_options<T>& options = {}) {
+		using lane_type = pack<T, W>;
+		using std::abs;
+
+		lane_type x{};
+		std::array<lane_type, P> lane_params{};
+		std::array<std::size_t, W> problem{};
+		std::array<std::size_t, W> iteration{};
+		std::array<bool, W> active{};
+
+		std::size_t next = 0;
+		std::size_t running = 0;
+		std::size_t failed = 0;
+
+		//空いたレーンに次の問題を読み込む
+		auto refill = [&](std::size_t lane) {
+			if (next < count) {
+				problem[lane] = next;
+				iteration[lane] = 0;
+				active[lane] = true;
+				x[lane] = x0[next];
+				for (std::size_t k = 0; k < P; ++k) lane_params[k][lane] = params[k][next];
+				++next;
+				++running;
+			} else {
+				active[lane] = false;
+			}
+		};
+
+		for (std::size_t lane = 0; lane < W; ++lane) refill(lane);
+
+		while (0 < running) {
+			const dual<lane_type> d = f(dual<lane_type>{ x, lane_type{ T(1.0) } }, static_cast<const std::array<lane_type, P>&>(lane_params));
+			const lane_type step = d.a() / d.b();
+			x -= step;
+
+			for (std::size_t lane = 0; lane < W; ++lane) {
+				if (!active[lane]) continue;
+
+				++iteration[lane];
+
+				//微分が0で更新量やxが∞、NaNになったレーンは、scaleも∞になり判定を通ってしまうので先に失敗とする
+				const bool finite = abs(step[lane]) < std::numeric_limits<T>::infinity() && abs(x[lane]) < std::numeric_limits<T>::infinity();
+				const T scale = (T(1.0) < abs(x[lane])) ? abs(x[lane]) : T(1.0);
+				const bool converged = finite && abs(step[lane]) <= options.tolerance * scale;
+
+				if (converged || !finite || options.max_iterations <= iteration[lane]) {
+					if (!converged) ++failed;
+
+					roots[problem[lane]] = x[lane];
+					if (iterations != nullptr) iterations[problem[lane]] = iteration[lane];
+
+					--running;
+					refill(lane);
+				}
+			}
+		}
+
+		return failed;
+	}
+
+	/**
+	* @brief レーン数を値型に合わせて選ぶバッチニュートン法
+	* @detail 256bit幅（doubleなら4、floatなら8レーン）を使う
+	*/
+	template<typename T, std::size_t P, typename Func>
+	std::size_t newton_batch(const T* x0, const std::array<const T*, P>& params, std::size_t count, Func&& f, T* roots, std::size_t* iterations, const newton_options<T>& options = {}) {
+		return newton_batch<32 / sizeof(T)>(x0, params, count, std::forward<Func>(f), roots, iterations, options);
+	}
+
+	/**
+	* @brief バッチニュートン法をスレッドプールで並列に実行する
+	* @detail 問題をchunk個ずつのタスクに分け、ワークスティーリングでスレッドに割り振る
+	*         各問題の反復はどのスレッドで解かれても同じなので、結果はスレッド数によらない
+	* @param pool 実行に使うスレッドプール
+	* @param chunk 1タスクあたりの問題の数、0ならstd::invalid_argumentを送出する
+	* @return 最大反復回数までに収束しなかった問題の数
+	*/
+	template<std::size_t W, typename T, std::size_t P, typename Func>
+	std::size_t parallel_newton_batch(thread_pool& pool, const T* x0, const std::array<const T*, P>& params, std::size_t count, Func&& f, T* roots, std::size_t* iterations, const newton_options<T>& options = {}, std::size_t chunk = 4096) {
+		if (chunk == 0) throw std::invalid_argument("parallel_newton_batch: chunk must be positive");
+
+		const std::size_t tasks = (count + chunk - 1) / chunk;
+		std::vector<std::size_t> failed(tasks, 0);
+
+		pool.parallel_for(tasks, [&](std::size_t task) {
+			const std::size_t first = task * chunk;
+			const std::size_t n = (count - first < chunk) ? count - first : chunk;
+
+			std::array<const T*, P> chunk_params{};
+			for (std::size_t k = 0; k < P; ++k) chunk_params[k] = params[k] + first;
+
+			failed[task] = newton_batch<W>(x0 + first, chunk_params, n, f, roots + first, (iterations != nullptr) ? iterations + first : nullptr, options);
+		});
+
+		std::size_t total = 0;
+		for (auto n : failed) total += n;
+
+		return total;
+	}
+
+	/**
+	* @brief レーン数を値型に合わせて選ぶ並列バッチニュートン法
+	*/
+	template<typename T, std::size_t P, typename Func>
+	std::size_t parallel_newton_batch(thread_pool& pool, const T* x0, const std::array<const T*, P>& params, std::size_t count, Func&& f, T* roots, std::size_t* iterations, const newton_options<T>& options = {}, std::size_t chunk = 4096) {
+		return parallel_newton_batch<32 / sizeof(T)>(pool, x0, params, count, std::forward<Func>(f), roots, iterations, options, chunk);
+	}
+}
@@ -0,0 +1,429 @@
+﻿#pragma once
+
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 微分が0と分かっている双対数（定数、パラメータ）
+	* @detail 値だけを保持し、演算子とcmath関数は微分の計算を一切しない
+	*         constant<T>同士の演算の結果はconstant<T>、dual<T>との演算は実数との演算と同じ計算で結果はdual<T>
+	*         dual_number_traitsを満たすので、dual<T>へは暗黙に変換できる（{a, 0}）
+	* @tparam T 値型、doubleと同じ操作ができる型
+	*/
+	template<typename T>
+	struct constant {
+		using this_type  = constant<T>;
+		using value_type = T;
+
+		/**
+		* デフォルトコンストラクタ
+		*/
+		constexpr constant()
+			: m_a{ 0.0 }
+		{}
+
+		/**
+		* 基本コンストラクタ、値を入れて構築
+		*/
+		constexpr explicit constant(T a)
+			: m_a{ a }
+		{}
+
+		constexpr constant(const this_type& other) = default;
+		constexpr constant(this_type&& other) = default;
+
+		constexpr this_type& operator=(const this_type& other) & = default;
+		constexpr this_type& operator=(this_type&& other) & = default;
+
+		constexpr this_type operator+() const {
+			return *this;
+		}
+
+		constexpr this_type operator-() const {
+			return this_type{ -m_a };
+		}
+
+		constexpr auto operator==(const this_type& rhs) const {
+			return m_a == rhs.m_a;
+		}
+
+		constexpr auto operator<(const this_type& rhs) const {
+			return m_a < rhs.m_a;
+		}
+
+		constexpr this_type& operator+=(const this_type& rhs) {
+			m_a += rhs.m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const T rhs) {
+			m_a += rhs;
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const this_type& rhs) {
+			m_a -= rhs.m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const T rhs) {
+			m_a -= rhs;
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const this_type& rhs) {
+			m_a *= rhs.m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const T rhs) {
+			m_a *= rhs;
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const this_type& rhs) {
+			m_a /= rhs.m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const T rhs) {
+			m_a /= rhs;
+			return *this;
+		}
+
+		/**
+		* 実部を取得する
+		* @return 実部の値
+		*/
+		constexpr T a() const {
+			return m_a;
+		}
+
+		/**
+		* 虚部を取得する
+		* @return 常に0
+		*/
+		constexpr T b() const {
+			return T(0.0);
+		}
+
+	private:
+		value_type m_a;
+	};
+
+	template<typename T>
+	constexpr auto operator!=(const constant<T>& lhs, const constant<T>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename T>
+	constexpr auto operator<=(const constant<T>& lhs, const constant<T>& rhs) {
+		return !(rhs < lhs);
+	}
+
+	template<typename T>
+	constexpr auto operator>(const constant<T>& lhs, const constant<T>& rhs) {
+		return rhs < lhs;
+	}
+
+	template<typename T>
+	constexpr auto operator>=(const constant<T>& lhs, const constant<T>& rhs) {
+		return !(lhs < rhs);
+	}
+
+	template<typename T>
+	constexpr auto operator+(const constant<T>& lhs, const constant<T>& rhs) {
+		return constant<T>{lhs} += rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator+(const constant<T>& lhs, const T rhs) {
+		return constant<T>{lhs} += rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator+(const T lhs, const constant<T>& rhs) {
+		return constant<T>{rhs} += lhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const constant<T>& lhs, const constant<T>& rhs) {
+		return constant<T>{lhs} -= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const constant<T>& lhs, const T rhs) {
+		return constant<T>{lhs} -= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const T lhs, const constant<T>& rhs) {
+		return constant<T>{lhs} -= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const constant<T>& lhs, const constant<T>& rhs) {
+		return constant<T>{lhs} *= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const constant<T>& lhs, const T rhs) {
+		return constant<T>{lhs} *= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const T lhs, const constant<T>& rhs) {
+		return constant<T>{rhs} *= lhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const constant<T>& lhs, const constant<T>& rhs) {
+		return constant<T>{lhs} /= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const constant<T>& lhs, const T rhs) {
+		return constant<T>{lhs} /= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const T lhs, const constant<T>& rhs) {
+		return constant<T>{lhs} /= rhs;
+	}
+
+	//dual<T>との演算は実数との演算に落とす（積は乗算2回、商は実数での除算）
+
+	template<typename T>
+	constexpr auto operator+(const dual<T>& lhs, const constant<T>& rhs) {
+		return lhs + rhs.a();
+	}
+
+	template<typename T>
+	constexpr auto operator+(const constant<T>& lhs, const dual<T>& rhs) {
+		return lhs.a() + rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const dual<T>& lhs, const constant<T>& rhs) {
+		return lhs - rhs.a();
+	}
+
+	template<typename T>
+	constexpr auto operator-(const constant<T>& lhs, const dual<T>& rhs) {
+		return lhs.a() - rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const dual<T>& lhs, const constant<T>& rhs) {
+		return lhs * rhs.a();
+	}
+
+	template<typename T>
+	constexpr auto operator*(const constant<T>& lhs, const dual<T>& rhs) {
+		return lhs.a() * rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const dual<T>& lhs, const constant<T>& rhs) {
+		return lhs / rhs.a();
+	}
+
+	template<typename T>
+	constexpr auto operator/(const constant<T>& lhs, const dual<T>& rhs) {
+		return lhs.a() / rhs;
+	}
+
+	template<typename T>
+	constexpr dual<T>& operator+=(dual<T>& lhs, const constant<T>& rhs) {
+		return lhs += rhs.a();
+	}
+
+	template<typename T>
+	constexpr dual<T>& operator-=(dual<T>& lhs, const constant<T>& rhs) {
+		return lhs -= rhs.a();
+	}
+
+	template<typename T>
+	constexpr dual<T>& operator*=(dual<T>& lhs, const constant<T>& rhs) {
+		return lhs *= rhs.a();
+	}
+
+	template<typename T>
+	constexpr dual<T>& operator/=(dual<T>& lhs, const constant<T>& rhs) {
+		return lhs /= rhs.a();
+	}
+
+	template<typename T>
+	std::ostream& operator<<(std::ostream& ostream, const constant<T>& rhs) {
+		ostream << rhs.a();
+		return ostream;
+	}
+
+	inline namespace cmath {
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atan2(const constant<T>& y, const constant<T>& x) {
+			return constant<T>{ Detail::atan2(y.a(), x.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const constant<T>& f, const constant<T>& y) {
+			return constant<T>{ Detail::pow(f.a(), y.a()) };
+		}
+
+		/**
+		* 指数が定数の双対数乗、pow(dual, 実数)と同じ
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual<T>& f, const constant<T>& y) {
+			return pow(f, y.a());
+		}
+
+		/**
+		* 底が定数の双対数乗、pow(実数, dual)と同じ
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const constant<T>& f, const dual<T>& y) {
+			return pow(f.a(), y);
+		}
+
+		template<typename T, typename Exponent>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const constant<T>& f, Exponent y) {
+			return constant<T>{ static_cast<T>(Detail::pow(f.a(), y)) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto hypot(const constant<T>& x, const constant<T>& y) {
+			return constant<T>{ Detail::hypot(x.a(), y.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sqrt(const constant<T>& c) {
+			return constant<T>{ Detail::sqrt(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto cbrt(const constant<T>& c) {
+			return constant<T>{ Detail::cbrt(c.a()) };
+		}
+
+		/**
+		* sinとcosを同時に計算する
+		* @return {sin(c), cos(c)}
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sincos(const constant<T>& c) {
+			const auto sc = Detail::sincos(c.a());
+			return std::pair<constant<T>, constant<T>>{ constant<T>{ sc.first }, constant<T>{ sc.second } };
+		}
+
+		/**
+		* dual<T>と違い、sinだけを計算する（cosは呼ばない）
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sin(const constant<T>& c) {
+			return constant<T>{ Detail::sin(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto cos(const constant<T>& c) {
+			return constant<T>{ Detail::cos(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto tan(const constant<T>& c) {
+			return constant<T>{ Detail::tan(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto asin(const constant<T>& c) {
+			return constant<T>{ Detail::asin(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto acos(const constant<T>& c) {
+			return constant<T>{ Detail::acos(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atan(const constant<T>& c) {
+			return constant<T>{ Detail::atan(c.a()) };
+		}
+
+		/**
+		* dual<T>と違い、sinhだけを計算する（coshは呼ばない）
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sinh(const constant<T>& c) {
+			return constant<T>{ Detail::sinh(c.a()) };
+		}
+
+		/**
+		* dual<T>と違い、coshだけを計算する（sinhは呼ばない）
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto cosh(const constant<T>& c) {
+			return constant<T>{ Detail::cosh(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto tanh(const constant<T>& c) {
+			return constant<T>{ Detail::tanh(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto asinh(const constant<T>& c) {
+			return constant<T>{ Detail::asinh(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto acosh(const constant<T>& c) {
+			return constant<T>{ Detail::acosh(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atanh(const constant<T>& c) {
+			return constant<T>{ Detail::atanh(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto exp(const constant<T>& c) {
+			return constant<T>{ Detail::exp(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto exp2(const constant<T>& c) {
+			return constant<T>{ Detail::exp2(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto expm1(const constant<T>& c) {
+			return constant<T>{ Detail::expm1(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log(const constant<T>& c) {
+			return constant<T>{ Detail::log(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log1p(const constant<T>& c) {
+			return constant<T>{ Detail::log1p(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log10(const constant<T>& c) {
+			return constant<T>{ Detail::log10(c.a()) };
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log2(const constant<T>& c) {
+			return constant<T>{ Detail::log2(c.a()) };
+		}
+	}
+}
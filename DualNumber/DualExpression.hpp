@@ -0,0 +1,488 @@
+﻿#pragma once
+
+#include <type_traits>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 双対数の式テンプレート（オプトイン）
+	* @detail lazy()で包んだ双対数に対する演算は式の木を返し、dual<T>への変換時に1回の走査で実部と虚部を同時に計算する
+	*         途中のdual<T>の一時オブジェクトを作らない、全ての節点はconstexprで評価できる
+	*/
+	namespace expression {
+
+		/**
+		* @brief 全ての式の節点の基底（CRTP）
+		* @tparam Derived 節点の型
+		* @tparam T 値型
+		*/
+		template<typename Derived, typename T>
+		struct node {
+			using value_type = T;
+
+			/**
+			* 式を評価する
+			* @return 実部と虚部を同時に計算した双対数
+			*/
+			constexpr dual<T> eval() const {
+				return static_cast<const Derived&>(*this).eval();
+			}
+
+			constexpr operator dual<T>() const {
+				return static_cast<const Derived&>(*this).eval();
+			}
+		};
+
+		template<typename E>
+		struct is_node {
+		private:
+			template<typename D, typename T>
+			static std::true_type check(const node<D, T>*);
+			static std::false_type check(...);
+
+		public:
+			static constexpr bool value = decltype(check(std::declval<const E*>()))::value;
+		};
+
+		template<typename E>
+		constexpr bool is_node_v = is_node<E>::value;
+
+		template<typename T>
+		struct is_dual : std::false_type {};
+
+		template<typename T>
+		struct is_dual<dual<T>> : std::true_type {};
+
+		/**
+		* @brief 二項演算の被演算子の組として適格か
+		* @detail 少なくとも一方が式の節点で、もう一方は節点か双対数であること
+		*/
+		template<typename L, typename R>
+		constexpr bool is_operand_pair_v = (is_node_v<L> || is_node_v<R>) && (is_node_v<L> || is_dual<L>::value) && (is_node_v<R> || is_dual<R>::value);
+
+		/**
+		* @brief 葉、双対数を値で保持する
+		*/
+		template<typename T>
+		struct terminal : node<terminal<T>, T> {
+			constexpr terminal(const dual<T>& value)
+				: m_value{ value }
+			{}
+
+			constexpr dual<T> eval() const {
+				return m_value;
+			}
+
+		private:
+			dual<T> m_value;
+		};
+
+		template<typename T>
+		constexpr auto as_node(const dual<T>& d) {
+			return terminal<T>{ d };
+		}
+
+		template<typename D, typename T>
+		constexpr const D& as_node(const node<D, T>& e) {
+			return static_cast<const D&>(e);
+		}
+
+		template<typename E>
+		using node_t = std::decay_t<decltype(as_node(std::declval<const E&>()))>;
+
+		struct add {
+			template<typename T>
+			static constexpr dual<T> apply(T la, T lb, T ra, T rb) {
+				return dual<T>{ la + ra, lb + rb };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_lhs(T s, T ra, T rb) {
+				return dual<T>{ s + ra, rb };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_rhs(T la, T lb, T s) {
+				return dual<T>{ la + s, lb };
+			}
+		};
+
+		struct subtract {
+			template<typename T>
+			static constexpr dual<T> apply(T la, T lb, T ra, T rb) {
+				return dual<T>{ la - ra, lb - rb };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_lhs(T s, T ra, T rb) {
+				return dual<T>{ s - ra, -rb };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_rhs(T la, T lb, T s) {
+				return dual<T>{ la - s, lb };
+			}
+		};
+
+		struct multiply {
+			template<typename T>
+			static constexpr dual<T> apply(T la, T lb, T ra, T rb) {
+				//(a+bε)*(c+dε) = ac + (ad + bc)ε、積和の形にしてFMAに縮約できるようにする
+				return dual<T>{ la * ra, la * rb + lb * ra };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_lhs(T s, T ra, T rb) {
+				return dual<T>{ s * ra, s * rb };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_rhs(T la, T lb, T s) {
+				return dual<T>{ la * s, lb * s };
+			}
+		};
+
+		struct divide {
+			template<typename T>
+			static constexpr dual<T> apply(T la, T lb, T ra, T rb) {
+				// (a+bε)/(c+dε) = a/c + (b - (a/c)d)ε/c
+				const T inv = T(1.0) / ra;
+				const T real = Detail::quotient(la, ra, inv);
+				return dual<T>{ real, (lb - real * rb) * inv };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_lhs(T s, T ra, T rb) {
+				// s/(c+dε) = s/c - (s/c)dε/c
+				const T inv = T(1.0) / ra;
+				const T real = Detail::quotient(s, ra, inv);
+				return dual<T>{ real, -real * rb * inv };
+			}
+
+			template<typename T>
+			static constexpr dual<T> apply_scalar_rhs(T la, T lb, T s) {
+				return dual<T>{ la / s, lb / s };
+			}
+		};
+
+		/**
+		* @brief 節点同士の二項演算
+		*/
+		template<typename Op, typename L, typename R>
+		struct binary : node<binary<Op, L, R>, typename L::value_type> {
+			using value_type = typename L::value_type;
+
+			constexpr binary(const L& lhs, const R& rhs)
+				: m_lhs{ lhs }
+				, m_rhs{ rhs }
+			{}
+
+			constexpr dual<value_type> eval() const {
+				const dual<value_type> l = m_lhs.eval();
+				const dual<value_type> r = m_rhs.eval();
+				return Op::apply(l.a(), l.b(), r.a(), r.b());
+			}
+
+		private:
+			L m_lhs;
+			R m_rhs;
+		};
+
+		/**
+		* @brief 左辺がスカラーの二項演算、スカラーの虚部（ゼロ）に関する計算を省く
+		*/
+		template<typename Op, typename R>
+		struct scalar_lhs : node<scalar_lhs<Op, R>, typename R::value_type> {
+			using value_type = typename R::value_type;
+
+			constexpr scalar_lhs(value_type lhs, const R& rhs)
+				: m_lhs{ lhs }
+				, m_rhs{ rhs }
+			{}
+
+			constexpr dual<value_type> eval() const {
+				const dual<value_type> r = m_rhs.eval();
+				return Op::apply_scalar_lhs(m_lhs, r.a(), r.b());
+			}
+
+		private:
+			value_type m_lhs;
+			R m_rhs;
+		};
+
+		/**
+		* @brief 右辺がスカラーの二項演算、スカラーの虚部（ゼロ）に関する計算を省く
+		*/
+		template<typename Op, typename L>
+		struct scalar_rhs : node<scalar_rhs<Op, L>, typename L::value_type> {
+			using value_type = typename L::value_type;
+
+			constexpr scalar_rhs(const L& lhs, value_type rhs)
+				: m_lhs{ lhs }
+				, m_rhs{ rhs }
+			{}
+
+			constexpr dual<value_type> eval() const {
+				const dual<value_type> l = m_lhs.eval();
+				return Op::apply_scalar_rhs(l.a(), l.b(), m_rhs);
+			}
+
+		private:
+			L m_lhs;
+			value_type m_rhs;
+		};
+
+		/**
+		* @brief 符号反転
+		*/
+		template<typename E>
+		struct negate : node<negate<E>, typename E::value_type> {
+			using value_type = typename E::value_type;
+
+			constexpr negate(const E& e)
+				: m_e{ e }
+			{}
+
+			constexpr dual<value_type> eval() const {
+				const dual<value_type> d = m_e.eval();
+				return dual<value_type>{ -d.a(), -d.b() };
+			}
+
+		private:
+			E m_e;
+		};
+
+		/**
+		* @brief cmathの関数の適用、部分式を評価した結果を関数に渡す
+		*/
+		template<typename Func, typename E>
+		struct function : node<function<Func, E>, typename E::value_type> {
+			using value_type = typename E::value_type;
+
+			constexpr function(const E& e)
+				: m_e{ e }
+			{}
+
+			dual<value_type> eval() const {
+				return Func{}(m_e.eval());
+			}
+
+		private:
+			E m_e;
+		};
+
+		/**
+		* 双対数を式の葉にする
+		* @brief これを起点とした演算は全て式の節点を返す
+		* @param d 双対数
+		*/
+		template<typename T>
+		constexpr auto lazy(const dual<T>& d) {
+			return terminal<T>{ d };
+		}
+
+		/**
+		* 式を評価する
+		* @param e 式
+		* @return 評価結果の双対数
+		*/
+		template<typename D, typename T>
+		constexpr dual<T> evaluate(const node<D, T>& e) {
+			return e.eval();
+		}
+
+		template<typename L, typename R, std::enable_if_t<is_operand_pair_v<L, R>, std::nullptr_t> = nullptr>
+		constexpr auto operator+(const L& lhs, const R& rhs) {
+			return binary<add, node_t<L>, node_t<R>>{ as_node(lhs), as_node(rhs) };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator+(const E& lhs, typename E::value_type rhs) {
+			return scalar_rhs<add, E>{ lhs, rhs };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator+(typename E::value_type lhs, const E& rhs) {
+			return scalar_lhs<add, E>{ lhs, rhs };
+		}
+
+		template<typename L, typename R, std::enable_if_t<is_operand_pair_v<L, R>, std::nullptr_t> = nullptr>
+		constexpr auto operator-(const L& lhs, const R& rhs) {
+			return binary<subtract, node_t<L>, node_t<R>>{ as_node(lhs), as_node(rhs) };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator-(const E& lhs, typename E::value_type rhs) {
+			return scalar_rhs<subtract, E>{ lhs, rhs };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator-(typename E::value_type lhs, const E& rhs) {
+			return scalar_lhs<subtract, E>{ lhs, rhs };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator-(const E& e) {
+			return negate<E>{ e };
+		}
+
+		template<typename L, typename R, std::enable_if_t<is_operand_pair_v<L, R>, std::nullptr_t> = nullptr>
+		constexpr auto operator*(const L& lhs, const R& rhs) {
+			return binary<multiply, node_t<L>, node_t<R>>{ as_node(lhs), as_node(rhs) };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator*(const E& lhs, typename E::value_type rhs) {
+			return scalar_rhs<multiply, E>{ lhs, rhs };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator*(typename E::value_type lhs, const E& rhs) {
+			return scalar_lhs<multiply, E>{ lhs, rhs };
+		}
+
+		template<typename L, typename R, std::enable_if_t<is_operand_pair_v<L, R>, std::nullptr_t> = nullptr>
+		constexpr auto operator/(const L& lhs, const R& rhs) {
+			return binary<divide, node_t<L>, node_t<R>>{ as_node(lhs), as_node(rhs) };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator/(const E& lhs, typename E::value_type rhs) {
+			return scalar_rhs<divide, E>{ lhs, rhs };
+		}
+
+		template<typename E, std::enable_if_t<is_node_v<E>, std::nullptr_t> = nullptr>
+		constexpr auto operator/(typename E::value_type lhs, const E& rhs) {
+			return scalar_lhs<divide, E>{ lhs, rhs };
+		}
+
+		struct sqrt_fn  { template<typename T> auto operator()(const dual<T>& d) const { return sqrt(d); } };
+		struct cbrt_fn  { template<typename T> auto operator()(const dual<T>& d) const { return cbrt(d); } };
+		struct sin_fn   { template<typename T> auto operator()(const dual<T>& d) const { return sin(d); } };
+		struct cos_fn   { template<typename T> auto operator()(const dual<T>& d) const { return cos(d); } };
+		struct tan_fn   { template<typename T> auto operator()(const dual<T>& d) const { return tan(d); } };
+		struct asin_fn  { template<typename T> auto operator()(const dual<T>& d) const { return asin(d); } };
+		struct acos_fn  { template<typename T> auto operator()(const dual<T>& d) const { return acos(d); } };
+		struct atan_fn  { template<typename T> auto operator()(const dual<T>& d) const { return atan(d); } };
+		struct sinh_fn  { template<typename T> auto operator()(const dual<T>& d) const { return sinh(d); } };
+		struct cosh_fn  { template<typename T> auto operator()(const dual<T>& d) const { return cosh(d); } };
+		struct tanh_fn  { template<typename T> auto operator()(const dual<T>& d) const { return tanh(d); } };
+		struct asinh_fn { template<typename T> auto operator()(const dual<T>& d) const { return asinh(d); } };
+		struct acosh_fn { template<typename T> auto operator()(const dual<T>& d) const { return acosh(d); } };
+		struct atanh_fn { template<typename T> auto operator()(const dual<T>& d) const { return atanh(d); } };
+		struct exp_fn   { template<typename T> auto operator()(const dual<T>& d) const { return exp(d); } };
+		struct exp2_fn  { template<typename T> auto operator()(const dual<T>& d) const { return exp2(d); } };
+		struct expm1_fn { template<typename T> auto operator()(const dual<T>& d) const { return expm1(d); } };
+		struct log_fn   { template<typename T> auto operator()(const dual<T>& d) const { return log(d); } };
+		struct log1p_fn { template<typename T> auto operator()(const dual<T>& d) const { return log1p(d); } };
+		struct log10_fn { template<typename T> auto operator()(const dual<T>& d) const { return log10(d); } };
+		struct log2_fn  { template<typename T> auto operator()(const dual<T>& d) const { return log2(d); } };
+
+		template<typename D, typename T>
+		auto sqrt(const node<D, T>& e) {
+			return function<sqrt_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto cbrt(const node<D, T>& e) {
+			return function<cbrt_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto sin(const node<D, T>& e) {
+			return function<sin_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto cos(const node<D, T>& e) {
+			return function<cos_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto tan(const node<D, T>& e) {
+			return function<tan_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto asin(const node<D, T>& e) {
+			return function<asin_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto acos(const node<D, T>& e) {
+			return function<acos_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto atan(const node<D, T>& e) {
+			return function<atan_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto sinh(const node<D, T>& e) {
+			return function<sinh_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto cosh(const node<D, T>& e) {
+			return function<cosh_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto tanh(const node<D, T>& e) {
+			return function<tanh_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto asinh(const node<D, T>& e) {
+			return function<asinh_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto acosh(const node<D, T>& e) {
+			return function<acosh_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto atanh(const node<D, T>& e) {
+			return function<atanh_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto exp(const node<D, T>& e) {
+			return function<exp_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto exp2(const node<D, T>& e) {
+			return function<exp2_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto expm1(const node<D, T>& e) {
+			return function<expm1_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto log(const node<D, T>& e) {
+			return function<log_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto log1p(const node<D, T>& e) {
+			return function<log1p_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto log10(const node<D, T>& e) {
+			return function<log10_fn, D>{ as_node(e) };
+		}
+
+		template<typename D, typename T>
+		auto log2(const node<D, T>& e) {
+			return function<log2_fn, D>{ as_node(e) };
+		}
+	}
+}
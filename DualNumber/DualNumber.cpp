@@ -82,6 +82,13 @@ int main()
 	constexpr bool gtq2 = d3 >= d2;
 
 	constexpr auto sqrt_n = sqrt_newton(10.0);
+
+#if DUALNUMBER_HAS_CONSTEXPR_CMATH
+	//cmathの関数も定数式で評価できる
+	constexpr auto sin_d = sin(0.5_d + 1.0_eps);
+	constexpr auto exp_d = exp(0.5_d + 1.0_eps);
+	constexpr auto log_d = log(2.0_d + 1.0_eps);
+#endif
 	auto sqrt_2 = std::sqrt(2.0);
 
 	std::cout << literal3 << std::endl;
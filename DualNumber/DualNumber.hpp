@@ -1,8 +1,27 @@
 #pragma once
 
+#include <array>
 #include <complex>
 #include <cmath>
+#include <cstddef>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+* cmath̑oΐ֐constexprɂł邩
+* @detail std::is_constant_evaluated()΁A萔̕]͒萔ŏꂽAsstd̊֐Ăѕ
+*/
+#if 201811L <= __cpp_lib_is_constant_evaluated
+#define DUALNUMBER_HAS_CONSTEXPR_CMATH 1
+#define DUALNUMBER_CONSTEXPR_CMATH constexpr
+#else
+#define DUALNUMBER_HAS_CONSTEXPR_CMATH 0
+#define DUALNUMBER_CONSTEXPR_CMATH
+#endif
 
 namespace DualNumbers {
 
@@ -12,11 +31,13 @@ namespace DualNumbers {
 	*/
 	template<typename T>
 	struct dual_number_traits {
-		static constexpr auto a(const T& val) {
+		template<typename U = T>
+		static constexpr auto a(const U& val) -> decltype(val.a()) {
 			return val.a();
 		}
 
-		static constexpr auto b(const T& val) {
+		template<typename U = T>
+		static constexpr auto b(const U& val) -> decltype(val.b()) {
 			return val.b();
 		}
 	};
@@ -36,6 +57,77 @@ namespace DualNumbers {
 		}
 	};
 
+	inline namespace cmath {
+
+		namespace Detail {
+
+			/**
+			* l^ɑ΂std::fmaPƂ̏ZƉZ葬
+			* @detail <cmath>FP_FAST_FMA*̓n[hEFAFMA߂gꍇɒ`
+			*         `ĂȂstd::fma̓\tgEFAł̃G~[VɂȂx
+			*/
+			template<typename T>
+			constexpr bool has_fast_fma = false;
+
+#ifdef FP_FAST_FMAF
+			template<>
+			constexpr bool has_fast_fma<float> = true;
+#endif
+#ifdef FP_FAST_FMA
+			template<>
+			constexpr bool has_fast_fma<double> = true;
+#endif
+#ifdef FP_FAST_FMAL
+			template<>
+			constexpr bool has_fast_fma<long double> = true;
+#endif
+
+			/**
+			* ̐Ϙaiς̔A̔Ȃǁjstd::fmaŋ߂邩
+			* @detail DUALNUMBER_USE_FMA`Ȃhas_fast_fmaɏ]
+			*         1ƒ`ƕ_^ł͏std::fmagiFMA߂ȂΒxjA0ƒ`ƏɏZƉZŋ߂
+			*/
+#ifdef DUALNUMBER_USE_FMA
+			template<typename T>
+			constexpr bool use_fma = (DUALNUMBER_USE_FMA != 0) && std::is_floating_point<T>::value;
+#else
+			template<typename T>
+			constexpr bool use_fma = has_fast_fma<T>;
+#endif
+
+			/**
+			* aEb + c
+			* @detail use_fma^̌^std::fma1̊ۂ߂ŋ߁AȊǑ^ƒ萔̕]͏ZƉZŋ߂
+			*/
+			template<typename T>
+			constexpr T fma(const T& a, const T& b, const T& c) {
+#if DUALNUMBER_HAS_CONSTEXPR_CMATH
+				if (std::is_constant_evaluated()) return a * b + c;
+#endif
+				if constexpr (use_fma<T>) {
+					return std::fma(a, b, c);
+				} else {
+					return a * b + c;
+				}
+			}
+
+			/**
+			* tg a/c
+			* @detail use_fma^̌^ aEr ] a - qEc 1␳i]fmaŌ덷Ȃ܂̂ a/c Ɠۂ߂ɂȂj
+			*         ȊǑ^͏]ۂ߂ĕ␳ɂȂȂ̂ŏZ
+			* @param r 1/c
+			*/
+			template<typename T>
+			constexpr T quotient(const T& a, const T& c, const T& r) {
+				if constexpr (use_fma<T>) {
+					const T q = a * r;
+					return fma(fma(-q, c, a), r, q);
+				} else {
+					return a / c;
+				}
+			}
+		}
+	}
 
 	/**
 	* @brief oΐidj̎
@@ -89,9 +181,10 @@ namespace DualNumbers {
 		/**
 		* ̑oΐ̕ϊRXgN^
 		* @brief ̌^ɓKdual_number_traits<T>̓ꉻKv
+		* @detail dual_number_traitsKpłȂ^iTɕϊłXJ[j̓I[o[[h₩O
 		* @param other Cӂ̑oΐ
 		*/
-		template<typename OtherDual>
+		template<typename OtherDual, typename = decltype(dual_number_traits<OtherDual>::a(std::declval<const OtherDual&>()))>
 		constexpr dual(const OtherDual& other)
 			: m_a{ T{dual_number_traits<OtherDual>::a(other)} }
 			, m_b{ T{dual_number_traits<OtherDual>::b(other)} }
@@ -115,13 +208,20 @@ namespace DualNumbers {
 			return this_type{ -m_a,-m_b };
 		}
 
-		constexpr bool operator==(const this_type& rhs) const {
-			//return m_a == rhs.m_a && m_b == rhs.m_b;
-			return std::tie(m_a, m_b) == std::tie(rhs.m_a, rhs.m_b);
+		/**
+		* lr
+		* @return TXJ[ȂboolASIMD^Ȃ炻̔rʂ̃}XN
+		*/
+		constexpr auto operator==(const this_type& rhs) const {
+			return m_a == rhs.m_a && m_b == rhs.m_b;
 		}
 
-		constexpr bool operator<(const this_type& rhs) const {
-			return std::tie(m_a, m_b) < std::tie(rhs.m_a, rhs.m_b);
+		/**
+		* ɂr
+		* @return TXJ[ȂboolASIMD^Ȃ炻̔rʂ̃}XN
+		*/
+		constexpr auto operator<(const this_type& rhs) const {
+			return m_a < rhs.m_a || (m_a == rhs.m_a && m_b < rhs.m_b);
 		}
 
 		constexpr this_type& operator++() {
@@ -162,8 +262,7 @@ namespace DualNumbers {
 
 		constexpr this_type& operator*=(const this_type& rhs) {
 			//(a+b)*(c+d) = ac + (ad + bc)
-			m_b *= rhs.m_a;
-			m_b += m_a * rhs.m_b;
+			m_b = Detail::fma(m_b, rhs.m_a, m_a * rhs.m_b);
 			m_a *= rhs.m_a;
 
 			return *this;
@@ -177,11 +276,12 @@ namespace DualNumbers {
 		}
 
 		constexpr this_type& operator/=(const this_type& rhs) {
-			// (a+b)/(c+d) = a/c + (-ad + bc)/c^2
-			m_b *= rhs.m_a;
-			m_b -= m_a * rhs.m_b;
-			m_b /= rhs.m_a * rhs.m_a;
-			m_a /= rhs.m_a;
+			// (a+b)/(c+d) = a/c + (-ad + bc)/c^2 = q + (b - qd)/cAq = a/c
+			//Z͋t1񂾂ɂāAlq͏]ŕ␳A͏Zfmaŋ߂
+			const T r = T(1.0) / rhs.m_a;
+			const T q = Detail::quotient(m_a, rhs.m_a, r);
+			m_b = Detail::fma(-q, rhs.m_b, m_b) * r;
+			m_a = q;
 
 			return *this;
 		}
@@ -200,8 +300,9 @@ namespace DualNumbers {
 		*/
 		constexpr void inverse() {
 			//d^-1 = 1/a - b/a^2
-			m_a = T(1.0) / m_a;
-			m_b /= -(m_a* m_a);
+			const T r = T(1.0) / m_a;
+			m_b = -m_b * r * r;
+			m_a = r;
 		}
 
 		/**
@@ -259,22 +360,22 @@ namespace DualNumbers {
 
 
 	template<typename T>
-	constexpr bool operator!=(const dual<T>& lhs, const dual<T>& rhs) {
+	constexpr auto operator!=(const dual<T>& lhs, const dual<T>& rhs) {
 		return !(lhs == rhs);
 	}
 
 	template<typename T>
-	constexpr bool operator<=(const dual<T>& lhs, const dual<T>& rhs) {
+	constexpr auto operator<=(const dual<T>& lhs, const dual<T>& rhs) {
 		return (lhs == rhs) || (lhs < rhs);
 	}
 
 	template<typename T>
-	constexpr bool operator>(const dual<T>& lhs, const dual<T>& rhs) {
+	constexpr auto operator>(const dual<T>& lhs, const dual<T>& rhs) {
 		return rhs < lhs;
 	}
 
 	template<typename T>
-	constexpr bool operator>=(const dual<T>& lhs, const dual<T>& rhs) {
+	constexpr auto operator>=(const dual<T>& lhs, const dual<T>& rhs) {
 		return (lhs == rhs) || (lhs > rhs);
 	}
 
@@ -347,9 +448,15 @@ namespace DualNumbers {
 		return dual<T>{lhs} /= rhs;
 	}
 
+	/**
+	* XJ[oΐŊ
+	* @detail s/(c+d) = s/c - (s/c)Ed/c ÁAt1񂾂߁AlDetail::quotientŕ␳
+	*/
 	template<typename T>
 	constexpr auto operator/(const T lhs, const dual<T>& rhs) {
-		return dual<T>{lhs} /= rhs;
+		const T r = T(1.0) / rhs.a();
+		const T q = Detail::quotient(lhs, rhs.a(), r);
+		return dual<T>{ q, -q * rhs.b() * r };
 	}
 
 	template<typename T>
@@ -404,207 +511,1055 @@ namespace DualNumbers {
 			constexpr T loge_10 = static_cast<T>(2.30258509299404568401799145468);
 		}
 
-		template<typename T>
-		auto atan2(const dual<T>& y, const dual<T>& x) {
-			using std::atan2;
+		namespace Detail {
+
+			/**
+			* @brief 萔̒Ŏg鐔w֐̎
+			* @detail ͍ł؂덷ȉɂȂ܂ő̂ŁAʂlibmƐULPقȂ肤
+			*         sin/cos/tan͈̔͏k |x| <= 2^19E/2 Ō덷ۏ؂A傫Ɛx
+			*         cmath̑oΐ֐͒萔̕]gAs͏]ʂstd̊֐Ă
+			*/
+			namespace Constexpr {
+
+				/**
+				* vZɎg^AfloatdoubleŌvZĊۂ߂
+				*/
+				template<typename T>
+				using work_t = std::conditional_t<std::is_same<T, float>::value, double, T>;
+
+				template<typename T> constexpr T ln2_hi   = static_cast<T>(6.93147180369123816490e-01L);
+				template<typename T> constexpr T ln2_lo   = static_cast<T>(1.90821492927058770002e-10L);
+				template<typename T> constexpr T ln2      = static_cast<T>(0.693147180559945309417232121458L);
+				template<typename T> constexpr T log2_e   = static_cast<T>(1.44269504088896340735992468100L);
+				template<typename T> constexpr T log10_2  = static_cast<T>(0.301029995663981195213738894724L);
+				template<typename T> constexpr T log10_e  = static_cast<T>(0.434294481903251827651128918917L);
+				template<typename T> constexpr T pi       = static_cast<T>(3.14159265358979323846264338328L);
+				template<typename T> constexpr T pi_2     = static_cast<T>(1.57079632679489661923132169164L);
+				template<typename T> constexpr T two_over_pi = static_cast<T>(0.636619772367581343075535053490L);
+				template<typename T> constexpr T sqrt2    = static_cast<T>(1.41421356237309504880168872421L);
+				template<typename T> constexpr T pio2_1   = static_cast<T>(1.57079632673412561417e+00L);
+				template<typename T> constexpr T pio2_2   = static_cast<T>(6.07710050630396597660e-11L);
+				template<typename T> constexpr T pio2_3   = static_cast<T>(2.02226624879595063154e-21L);
+
+				template<typename T>
+				constexpr bool isnan(T x) {
+					return x != x;
+				}
+
+				template<typename T>
+				constexpr T abs(T x) {
+					return (x < T(0.0)) ? -x : x;
+				}
+
+				template<typename T>
+				constexpr T nan() {
+					return std::numeric_limits<T>::quiet_NaN();
+				}
+
+				template<typename T>
+				constexpr T infinity() {
+					return std::numeric_limits<T>::infinity();
+				}
+
+				/**
+				* ł߂A|x| < 2^62 ł邱
+				*/
+				template<typename T>
+				constexpr long long round(T x) {
+					return static_cast<long long>((x < T(0.0)) ? x - T(0.5) : x + T(0.5));
+				}
+
+				/**
+				* 2^64A2̗ݏȂ̂ŋt덷Ȃ܂
+				*/
+				template<typename T>
+				constexpr T two_64 = static_cast<T>(18446744073709551616.0L);
+
+				/**
+				* xE2^e
+				* @detail 2^642JԂ|AʂKȂ덷͂Ȃ
+				*/
+				template<typename T>
+				constexpr T scale2(T x, long long e) {
+					for (; 64 <= e; e -= 64) x *= two_64<T>;
+					for (; e <= -64; e += 64) x *= T(1.0) / two_64<T>;
+					for (; 0 < e; --e) x *= T(2.0);
+					for (; e < 0; ++e) x *= T(0.5);
+					return x;
+				}
+
+				/**
+				* ̗Ll mE2^eAm[1, 2) ɕ
+				* @return m
+				*/
+				template<typename T>
+				constexpr T decompose(T x, long long& e) {
+					e = 0;
+					while (two_64<T> <= x) { x *= T(1.0) / two_64<T>; e += 64; }
+					while (x < T(1.0) / two_64<T>) { x *= two_64<T>; e -= 64; }
+					while (T(2.0) <= x) { x *= T(0.5); ++e; }
+					while (x < T(1.0)) { x *= T(2.0); --e; }
+					return x;
+				}
+
+				/**
+				* exp(x)E2^e
+				* @detail x = kEln2 + rA|r| <= ln2/2 ɏkexp(r)eC[ŋ߂
+				*/
+				template<typename T>
+				constexpr T exp_scaled(T x, long long e) {
+					if (isnan(x)) return x;
+					if (T(std::numeric_limits<T>::max_exponent + 1) * ln2<T> < x) return infinity<T>();
+					if (x < T(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1) * ln2<T>) return T(0.0);
+
+					const long long k = round(x * log2_e<T>);
+					const T r = (x - T(k) * ln2_hi<T>) - T(k) * ln2_lo<T>;
+
+					T sum = T(1.0);
+					T term = T(1.0);
+					for (int n = 1; n < 64; ++n) {
+						term *= r / T(n);
+						const T next = sum + term;
+						if (next == sum) break;
+						sum = next;
+					}
+
+					return scale2(sum, k + e);
+				}
+
+				template<typename T>
+				constexpr T exp(T x) {
+					return exp_scaled(x, 0);
+				}
+
+				template<typename T>
+				constexpr T exp2(T x) {
+					if (isnan(x)) return x;
+					if (T(std::numeric_limits<T>::max_exponent + 1) < x) return infinity<T>();
+					if (x < T(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1)) return T(0.0);
+
+					//2^x = 2^kEexp((x - k)Eln2)Ax - k ͌덷Ȃ܂
+					const long long k = round(x);
+					return exp_scaled((x - T(k)) * ln2<T>, k);
+				}
+
+				template<typename T>
+				constexpr T expm1(T x) {
+					if (!(abs(x) < T(0.5))) return exp(x) - T(1.0);
+
+					//0t߂ł exp(x) - 1 ̂1eC[𒼐ڑ
+					T sum = x;
+					T term = x;
+					for (int n = 2; n < 64; ++n) {
+						term *= x / T(n);
+						const T next = sum + term;
+						if (next == sum) break;
+						sum = next;
+					}
+					return sum;
+				}
+
+				/**
+				* 2Eatanh(s) = log((1 + s)/(1 - s)) ̋
+				*/
+				template<typename T>
+				constexpr T log_series(T s) {
+					const T s2 = s * s;
+					T sum = s;
+					T power = s;
+					for (int n = 3; n < 256; n += 2) {
+						power *= s2;
+						const T next = sum + power / T(n);
+						if (next == sum) break;
+						sum = next;
+					}
+					return T(2.0) * sum;
+				}
+
+				/**
+				* ̗Ll x = mE2^eAm[2/2, 2) ɕAlog(m)Ԃ
+				*/
+				template<typename T>
+				constexpr T log_reduced(T x, long long& e) {
+					T m = decompose(x, e);
+					if (sqrt2<T> < m) {
+						m *= T(0.5);
+						++e;
+					}
+					return log_series((m - T(1.0)) / (m + T(1.0)));
+				}
+
+				template<typename T>
+				constexpr T log(T x) {
+					if (isnan(x) || x < T(0.0)) return nan<T>();
+					if (x == T(0.0)) return -infinity<T>();
+					if (x == infinity<T>()) return x;
+
+					long long e = 0;
+					const T lm = log_reduced(x, e);
+					return T(e) * ln2_hi<T> + (T(e) * ln2_lo<T> + lm);
+				}
+
+				template<typename T>
+				constexpr T log2(T x) {
+					if (isnan(x) || x < T(0.0)) return nan<T>();
+					if (x == T(0.0)) return -infinity<T>();
+					if (x == infinity<T>()) return x;
+
+					long long e = 0;
+					const T lm = log_reduced(x, e);
+					return T(e) + lm * log2_e<T>;
+				}
+
+				template<typename T>
+				constexpr T log10(T x) {
+					if (isnan(x) || x < T(0.0)) return nan<T>();
+					if (x == T(0.0)) return -infinity<T>();
+					if (x == infinity<T>()) return x;
+
+					long long e = 0;
+					const T lm = log_reduced(x, e);
+					return T(e) * log10_2<T> + lm * log10_e<T>;
+				}
+
+				template<typename T>
+				constexpr T log1p(T x) {
+					if (isnan(x) || x < T(-1.0)) return nan<T>();
+					if (x == T(-1.0)) return -infinity<T>();
+					if (!(abs(x) < T(0.5))) return log(T(1.0) + x);
+
+					//log(1 + x) = 2Eatanh(x / (2 + x))A1 + x ̊ۂ߂
+					return log_series(x / (T(2.0) + x));
+				}
+
+				/**
+				* 
+				* @detail [1, 4)ɑAォPɋ߂Âj[g@ȂȂ܂ŌJԂ
+				*/
+				template<typename T>
+				constexpr T sqrt(T x) {
+					if (isnan(x) || x < T(0.0)) return nan<T>();
+					if (x == T(0.0) || x == infinity<T>()) return x;
+
+					long long e = 0;
+					T m = decompose(x, e);
+					if (e % 2 != 0) {
+						m *= T(2.0);
+						--e;
+					}
+
+					T y = m;
+					while (true) {
+						const T next = T(0.5) * (y + m / y);
+						if (!(next < y)) break;
+						y = next;
+					}
+
+					return scale2(y, e / 2);
+				}
+
+				/**
+				* 
+				* @detail [1, 8)ɑAsqrtƓォ̃j[g@ŋ߂
+				*/
+				template<typename T>
+				constexpr T cbrt(T x) {
+					if (isnan(x) || x == T(0.0) || abs(x) == infinity<T>()) return x;
+
+					long long e = 0;
+					T m = decompose(abs(x), e);
+					while (e % 3 != 0) {
+						m *= T(2.0);
+						--e;
+					}
+
+					T y = m;
+					while (true) {
+						const T next = (y + y + m / (y * y)) / T(3.0);
+						if (!(next < y)) break;
+						y = next;
+					}
+
+					const T result = scale2(y, e / 3);
+					return (x < T(0.0)) ? -result : result;
+				}
+
+				template<typename T>
+				constexpr T hypot(T x, T y) {
+					x = abs(x);
+					y = abs(y);
+					if (x == infinity<T>() || y == infinity<T>()) return infinity<T>();
+					if (isnan(x) || isnan(y)) return nan<T>();
+
+					const T large = (x < y) ? y : x;
+					const T small = (x < y) ? x : y;
+					if (large == T(0.0)) return large;
+
+					const T r = small / large;
+					return large * sqrt(T(1.0) + r * r);
+				}
+
+				/**
+				* {sin(x), cos(x)}
+				* @detail /23Cody-Waite@[-/4, /4]ɏkAꂼeC[ŋ߂
+				*/
+				template<typename T>
+				constexpr std::pair<T, T> sincos(T x) {
+					if (isnan(x) || !(abs(x) < T(4.0e18))) return { nan<T>(), nan<T>() };
+
+					const long long n = round(x * two_over_pi<T>);
+					const T fn = T(n);
+					const T r = ((x - fn * pio2_1<T>) - fn * pio2_2<T>) - fn * pio2_3<T>;
+					const T z = r * r;
+
+					T s = r;
+					T c = T(1.0);
+					T ts = r;
+					T tc = T(1.0);
+					for (int k = 1; k < 64; ++k) {
+						ts *= -z / T((2 * k) * (2 * k + 1));
+						tc *= -z / T((2 * k - 1) * (2 * k));
+						const T next_s = s + ts;
+						const T next_c = c + tc;
+						if (next_s == s && next_c == c) break;
+						s = next_s;
+						c = next_c;
+					}
+
+					switch (static_cast<unsigned long long>(n) & 3) {
+					case 0:  return { s, c };
+					case 1:  return { c, -s };
+					case 2:  return { -s, -c };
+					default: return { -c, s };
+					}
+				}
+
+				template<typename T>
+				constexpr T sin(T x) {
+					return sincos(x).first;
+				}
+
+				template<typename T>
+				constexpr T cos(T x) {
+					return sincos(x).second;
+				}
+
+				template<typename T>
+				constexpr T tan(T x) {
+					const auto sc = sincos(x);
+					return sc.first / sc.second;
+				}
+
+				/**
+				* t
+				* @detail |x| > 1  /2 - atan(1/x)Aɔp atan(x) = 2Eatan(x / (1 + (1 + x^2)))  |x| <= 1/8 ܂ŏkċŋ߂
+				*/
+				template<typename T>
+				constexpr T atan(T x) {
+					if (isnan(x)) return x;
+					if (x < T(0.0)) return -atan(-x);
+					if (x == infinity<T>()) return pi_2<T>;
+					if (T(1.0) < x) return pi_2<T> - atan(T(1.0) / x);
+
+					long long halvings = 0;
+					while (T(0.125) < x) {
+						x = x / (T(1.0) + sqrt(T(1.0) + x * x));
+						++halvings;
+					}
+
+					const T z = x * x;
+					T sum = x;
+					T power = x;
+					for (int n = 3; n < 256; n += 2) {
+						power *= -z;
+						const T next = sum + power / T(n);
+						if (next == sum) break;
+						sum = next;
+					}
+
+					return scale2(sum, halvings);
+				}
+
+				/**
+				* 2̋t
+				* @detail [͋̕ʂȂ
+				*/
+				template<typename T>
+				constexpr T atan2(T y, T x) {
+					if (isnan(x) || isnan(y)) return nan<T>();
+					if (x == T(0.0)) {
+						if (y == T(0.0)) return y;
+						return (T(0.0) < y) ? pi_2<T> : -pi_2<T>;
+					}
+
+					const T a = atan(y / x);
+					if (T(0.0) < x) return a;
+					return (y < T(0.0)) ? a - pi<T> : a + pi<T>;
+				}
+
+				template<typename T>
+				constexpr T asin(T x) {
+					if (isnan(x) || T(1.0) < abs(x)) return nan<T>();
+					return atan2(x, sqrt((T(1.0) - x) * (T(1.0) + x)));
+				}
+
+				template<typename T>
+				constexpr T acos(T x) {
+					if (isnan(x) || T(1.0) < abs(x)) return nan<T>();
+					return atan2(sqrt((T(1.0) - x) * (T(1.0) + x)), x);
+				}
+
+				template<typename T>
+				constexpr T sinh(T x) {
+					const T a = abs(x);
+					T result{};
+					if (a < T(1.0)) {
+						const T e = expm1(a);
+						result = T(0.5) * (e + e / (e + T(1.0)));
+					} else {
+						//exp(a)/2 𒼐ڍ邱ƂŁAsinh(a)LȔ͈͂ł̃I[o[t[
+						const T e = exp_scaled(a, -1);
+						result = e - T(0.25) / e;
+					}
+					return (x < T(0.0)) ? -result : result;
+				}
+
+				template<typename T>
+				constexpr T cosh(T x) {
+					const T e = exp_scaled(abs(x), -1);
+					return e + T(0.25) / e;
+				}
+
+				template<typename T>
+				constexpr T tanh(T x) {
+					if (isnan(x)) return x;
+
+					const T a = abs(x);
+					T result = T(1.0);
+					if (a < T(40.0)) {
+						const T e = expm1(a + a);
+						result = e / (e + T(2.0));
+					}
+					return (x < T(0.0)) ? -result : result;
+				}
+
+				template<typename T>
+				constexpr T asinh(T x) {
+					if (isnan(x)) return x;
+
+					const T a = abs(x);
+					T result{};
+					if (T(1.0) / std::numeric_limits<T>::epsilon() < a) {
+						result = log(a) + ln2<T>;
+					} else {
+						//log(a + (a^2 + 1)) = log1p(a + a^2 / (1 + (1 + a^2)))
+						result = log1p(a + a * a / (T(1.0) + sqrt(T(1.0) + a * a)));
+					}
+					return (x < T(0.0)) ? -result : result;
+				}
+
+				template<typename T>
+				constexpr T acosh(T x) {
+					if (isnan(x) || x < T(1.0)) return nan<T>();
+					if (T(1.0) / std::numeric_limits<T>::epsilon() < x) return log(x) + ln2<T>;
+
+					const T t = x - T(1.0);
+					return log1p(t + sqrt(t * (x + T(1.0))));
+				}
+
+				template<typename T>
+				constexpr T atanh(T x) {
+					if (isnan(x) || T(1.0) < abs(x)) return nan<T>();
+
+					const T a = abs(x);
+					const T result = (a == T(1.0)) ? infinity<T>() : T(0.5) * log1p((a + a) / (T(1.0) - a));
+					return (x < T(0.0)) ? -result : result;
+				}
+
+				/**
+				* ׂ
+				* @detail wȂ񕪗ݏAȊO exp(yElog(x)) ŋ߂̂ŁA덷 |yElog(x)| ɔႵđ傫Ȃ
+				*/
+				template<typename T>
+				constexpr T pow(T x, T y) {
+					if (y == T(0.0) || x == T(1.0)) return T(1.0);
+					if (isnan(x) || isnan(y)) return nan<T>();
+
+					const bool integral = abs(y) < T(4.0e18) && T(static_cast<long long>(y)) == y;
+
+					if (x < T(0.0)) {
+						if (!integral) return nan<T>();
+						const T result = pow(-x, y);
+						return (static_cast<unsigned long long>(static_cast<long long>(y)) & 1) ? -result : result;
+					}
+					if (x == T(0.0)) return (T(0.0) < y) ? T(0.0) : infinity<T>();
+					if (x == infinity<T>()) return (T(0.0) < y) ? infinity<T>() : T(0.0);
+
+					if (integral && abs(y) < T(2147483648.0)) {
+						long long n = static_cast<long long>(abs(y));
+						T base = x;
+						T result = T(1.0);
+						while (0 < n) {
+							if (n & 1) result *= base;
+							base *= base;
+							n >>= 1;
+						}
+						return (y < T(0.0)) ? T(1.0) / result : result;
+					}
+
+					return exp(y * log(x));
+				}
+			}
+
+			/**
+			* 萔̕]ȂConstexpr̎AłȂruntimeĂ
+			* @detail SĎZp^ŁA̋ʌ^_^̎؂ւ
+			*         ȊǑ^ipackAoΐ̓qȂǁj͏runtimeĂсAusing std::f; f(x); ɂADL̂܂ܕۂ
+			* @param constant Constexpr̎ĂԊ֐
+			* @param runtime std̊֐ĂԊ֐
+			*/
+			template<typename Constant, typename Runtime, typename... Args>
+			DUALNUMBER_CONSTEXPR_CMATH auto evaluate(Constant&& constant, Runtime&& runtime, const Args&... args) {
+#if DUALNUMBER_HAS_CONSTEXPR_CMATH
+				if constexpr (std::conjunction<std::is_arithmetic<Args>...>::value) {
+					using common_type = std::common_type_t<Args...>;
+					using result_type = decltype(runtime(args...));
+
+					if constexpr (std::is_floating_point<common_type>::value) {
+						if (std::is_constant_evaluated()) {
+							return static_cast<result_type>(constant(static_cast<Constexpr::work_t<common_type>>(args)...));
+						}
+					}
+				}
+#else
+				static_cast<void>(constant);
+#endif
+				return runtime(args...);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto sqrt(const T& x) {
+				return evaluate([](auto v) { return Constexpr::sqrt(v); }, [](const auto& v) { using std::sqrt; return sqrt(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto cbrt(const T& x) {
+				return evaluate([](auto v) { return Constexpr::cbrt(v); }, [](const auto& v) { using std::cbrt; return cbrt(v); }, x);
+			}
+
+			template<typename T, typename U>
+			DUALNUMBER_CONSTEXPR_CMATH auto hypot(const T& x, const U& y) {
+				return evaluate([](auto v, auto w) { return Constexpr::hypot(v, w); }, [](const auto& v, const auto& w) { using std::hypot; return hypot(v, w); }, x, y);
+			}
+
+			template<typename T, typename U>
+			DUALNUMBER_CONSTEXPR_CMATH auto pow(const T& x, const U& y) {
+				return evaluate([](auto v, auto w) { return Constexpr::pow(v, w); }, [](const auto& v, const auto& w) { using std::pow; return pow(v, w); }, x, y);
+			}
+
+			/**
+			* 񕉐 x^k
+			* @detail i@iJԂ@jŏZŋ߂
+			*/
+			template<typename T>
+			constexpr T ipow(const T& x, unsigned long long k) {
+				T base = x;
+				T result = T(1.0);
+				while (k != 0) {
+					if (k & 1ull) result *= base;
+					k >>= 1;
+					if (k != 0) base *= base;
+				}
+				return result;
+			}
+
+			template<typename T, typename U>
+			DUALNUMBER_CONSTEXPR_CMATH auto atan2(const T& y, const U& x) {
+				return evaluate([](auto v, auto w) { return Constexpr::atan2(v, w); }, [](const auto& v, const auto& w) { using std::atan2; return atan2(v, w); }, y, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto tan(const T& x) {
+				return evaluate([](auto v) { return Constexpr::tan(v); }, [](const auto& v) { using std::tan; return tan(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto asin(const T& x) {
+				return evaluate([](auto v) { return Constexpr::asin(v); }, [](const auto& v) { using std::asin; return asin(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto acos(const T& x) {
+				return evaluate([](auto v) { return Constexpr::acos(v); }, [](const auto& v) { using std::acos; return acos(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto atan(const T& x) {
+				return evaluate([](auto v) { return Constexpr::atan(v); }, [](const auto& v) { using std::atan; return atan(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto sinh(const T& x) {
+				return evaluate([](auto v) { return Constexpr::sinh(v); }, [](const auto& v) { using std::sinh; return sinh(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto cosh(const T& x) {
+				return evaluate([](auto v) { return Constexpr::cosh(v); }, [](const auto& v) { using std::cosh; return cosh(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto tanh(const T& x) {
+				return evaluate([](auto v) { return Constexpr::tanh(v); }, [](const auto& v) { using std::tanh; return tanh(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto asinh(const T& x) {
+				return evaluate([](auto v) { return Constexpr::asinh(v); }, [](const auto& v) { using std::asinh; return asinh(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto acosh(const T& x) {
+				return evaluate([](auto v) { return Constexpr::acosh(v); }, [](const auto& v) { using std::acosh; return acosh(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto atanh(const T& x) {
+				return evaluate([](auto v) { return Constexpr::atanh(v); }, [](const auto& v) { using std::atanh; return atanh(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto exp(const T& x) {
+				return evaluate([](auto v) { return Constexpr::exp(v); }, [](const auto& v) { using std::exp; return exp(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto exp2(const T& x) {
+				return evaluate([](auto v) { return Constexpr::exp2(v); }, [](const auto& v) { using std::exp2; return exp2(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto expm1(const T& x) {
+				return evaluate([](auto v) { return Constexpr::expm1(v); }, [](const auto& v) { using std::expm1; return expm1(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto log(const T& x) {
+				return evaluate([](auto v) { return Constexpr::log(v); }, [](const auto& v) { using std::log; return log(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto log1p(const T& x) {
+				return evaluate([](auto v) { return Constexpr::log1p(v); }, [](const auto& v) { using std::log1p; return log1p(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto log10(const T& x) {
+				return evaluate([](auto v) { return Constexpr::log10(v); }, [](const auto& v) { using std::log10; return log10(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto log2(const T& x) {
+				return evaluate([](auto v) { return Constexpr::log2(v); }, [](const auto& v) { using std::log2; return log2(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto sin(const T& x) {
+				return evaluate([](auto v) { return Constexpr::sin(v); }, [](const auto& v) { using std::sin; return sin(v); }, x);
+			}
+
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto cos(const T& x) {
+				return evaluate([](auto v) { return Constexpr::cos(v); }, [](const auto& v) { using std::cos; return cos(v); }, x);
+			}
+
+			/**
+			* sincos𓯎ɌvZ
+			* @detail p̎Ȃ^std::sin/std::cosꂼĂ
+			*         floatgidouble̐pŌvZĊۂ߂floatstd::sin/std::cosxj
+			* @return {sin(x), cos(x)}
+			*/
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH auto sincos(const T& x) {
+				return evaluate([](auto v) { return Constexpr::sincos(v); }, [](const auto& v) { using std::sin; using std::cos; return std::pair<T, T>{ sin(v), cos(v) }; }, x);
+			}
+
+			/**
+			* sincos1͈̔͏kƑ]œɌvZ
+			* @detail fdlibmƓ/2Cody-Waite@3[-/4, /4]ɏkA__kernel_sin/__kernel_cos̑ŕ]
+			*         ǩ덷ۏ؂łȂ |x| > 2^19E/2 NaNAstd::sin/std::cosɔC
+			* @return {sin(x), cos(x)}
+			*/
+			DUALNUMBER_CONSTEXPR_CMATH inline auto sincos(double x) {
+#if DUALNUMBER_HAS_CONSTEXPR_CMATH
+				if (std::is_constant_evaluated()) return Constexpr::sincos(x);
+#endif
+				if (!(std::abs(x) <= 823549.6)) {
+					return std::pair<double, double>{ std::sin(x), std::cos(x) };
+				}
+
+				constexpr double invpio2 = 6.36619772367581382433e-01;
+				constexpr double pio2_1  = 1.57079632673412561417e+00;
+				constexpr double pio2_2  = 6.07710050630396597660e-11;
+				constexpr double pio2_2t = 2.02226624879595063154e-21;
+				constexpr double pio2_3  = 2.02226624871116645580e-21;
+				constexpr double pio2_3t = 8.47842766036889956997e-32;
+				constexpr double shift   = 6755399441055744.0;  //1.5 * 2^52AĈƐɊۂ߂
+
+				//x = nE/2 + (y0 + y1)
+				const double fn = (x * invpio2 + shift) - shift;
+				const long long n = static_cast<long long>(fn);
+
+				double r = x - fn * pio2_1;
+				double w = fn * pio2_2;
+				double t = r;
+				r = t - w;
+				w = fn * pio2_2t - ((t - r) - w);
+				t = r;
+				w = fn * pio2_3;
+				r = t - w;
+				w = fn * pio2_3t - ((t - r) - w);
+				const double y0 = r - w;
+				const double y1 = (r - y0) - w;
+
+				const double z = y0 * y0;
+
+				//__kernel_sin
+				const double v = z * y0;
+				const double ps = 8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)));
+				const double sin_r = y0 - ((z * (0.5 * y1 - v * ps) - y1) - v * -1.66666666666666324348e-01);
+
+				//__kernel_cos
+				const double zz = z * z;
+				const double pc = z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * 2.48015872894767294178e-05)) + zz * zz * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11));
+				const double hz = 0.5 * z;
+				const double one_hz = 1.0 - hz;
+				const double cos_r = one_hz + (((1.0 - one_hz) - hz) + (z * pc - y0 * y1));
+
+				switch (n & 3) {
+				case 0:  return std::pair<double, double>{ sin_r, cos_r };
+				case 1:  return std::pair<double, double>{ cos_r, -sin_r };
+				case 2:  return std::pair<double, double>{ -sin_r, -cos_r };
+				default: return std::pair<double, double>{ -cos_r, sin_r };
+				}
+			}
+
+			/**
+			* r}XNԂAwhereŃ[ɑIł^iSimdPackpackȂǁj
+			*/
+			template<typename T, typename = void>
+			struct is_lane_selectable : std::false_type {};
+
+			template<typename T>
+			struct is_lane_selectable<T, std::void_t<decltype(where(std::declval<const T&>() < std::declval<const T&>(), std::declval<const T&>(), std::declval<const T&>()))>> : std::true_type {};
+
+			/**
+			* x^y̒lxɂĂ̔ yEx^(y-1) ߂
+			* @detail ꂪȂ yEvalue/x ƂpowĂ΂ȂilI[o[t[ꍇ͔ɂȂj
+			*         ꂪłȂꍇ́A0̒╉̒̐𐳂悤x^(y-1)߂
+			*         SIMD[^ł̓[whereőI
+			*/
+			template<typename T, typename Exponent>
+			DUALNUMBER_CONSTEXPR_CMATH T pow_derivative(const T& x, const Exponent& y, const T& value) {
+				if constexpr (std::is_floating_point<T>::value) {
+					if (!(T(0.0) < x)) return static_cast<T>(y) * T(pow(x, y - T(1.0)));
+				} else if constexpr (is_lane_selectable<T>::value) {
+					const T exponent = static_cast<T>(y);
+					return where(T(0.0) < x, exponent * value / x, exponent * T(pow(x, exponent - T(1.0))));
+				}
+				return static_cast<T>(y) * value / x;
+			}
+
+			/**
+			* atan2(y, x)̒lƕΔ {atan2(y, x), /y, /x}
+			* @detail /y = x/(x^2 + y^2)A/x = -y/(x^2 + y^2) ŁAZ1
+			*         1dual (xEy' - yEx')/(x^2 + y^2) Ƃ܂Ƃ߂Ċ|
+			*/
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH std::array<T, 3> atan2_partials(const T& y, const T& x) {
+				const T sumsq_inv = T(1.0) / fma(x, x, y * y);
+				return { T(atan2(y, x)), x * sumsq_inv, -y * sumsq_inv };
+			}
+
+			/**
+			* hypot(x, y)̒lƕΔ {hypot(x, y), /x, /y}
+			* @detail /x = x/hypotA/y = y/hypot ŁAt|3:4:5̂悤ȐmȔۂ߂̂ŏZ
+			*         1dual (xEx' + yEy')/hypot ƂďZ1ɂ
+			*/
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH std::array<T, 3> hypot_partials(const T& x, const T& y) {
+				const T h = hypot(x, y);
+				return { h, x / h, y / h };
+			}
 
-			auto sumsq_inv = T(1.0) / (x.a() * x.a() + y.a() * y.a());
-			return dual<T>{atan2(y.a(), x.a()), sumsq_inv*(-y.a()*x.b() + x.a()*y.b())};
+			/**
+			* f^y̒lƕΔ {f^y, /f, /y}
+			* @detail lpowŋ߂̂ŐxstdƓAꂪȂ /f = yEf^y/fA/y = f^yElog(f) Ƃpowlog2ōς܂
+			*         ꂪłȂꍇ́A0̒╉̒̐𐳂悤 /f = yEf^(y-1) ƂAl0Ȃ /y 0Ƃ
+			*         SIMD[^ł̓[whereőI
+			*/
+			template<typename T>
+			DUALNUMBER_CONSTEXPR_CMATH std::array<T, 3> pow_partials(const T& f, const T& y) {
+				if constexpr (std::is_floating_point<T>::value) {
+					if (!(T(0.0) < f)) {
+						const T value = pow(f, y);
+						return { value, y * T(pow(f, y - T(1.0))), (value == T(0.0)) ? T(0.0) : value * T(log(f)) };
+					}
+				} else if constexpr (is_lane_selectable<T>::value) {
+					const T value = pow(f, y);
+					const auto positive = T(0.0) < f;
+					return {
+						value,
+						where(positive, y * value / f, y * T(pow(f, y - T(1.0)))),
+						where(value == T(0.0), T(0.0), value * T(log(f)))
+					};
+				}
+				const T value = pow(f, y);
+				return { value, y * value / f, value * T(log(f)) };
+			}
 		}
 
 		template<typename T>
-		auto pow(const dual<T>& f, const dual<T>& y) {
-			using std::pow;
+		DUALNUMBER_CONSTEXPR_CMATH auto atan2(const dual<T>& y, const dual<T>& x) {
+			auto sumsq_inv = T(1.0) / Detail::fma(x.a(), x.a(), y.a() * y.a());
+			return dual<T>{Detail::atan2(y.a(), x.a()), sumsq_inv * Detail::fma(x.a(), y.b(), -y.a() * x.b())};
+		}
+
+		/**
+		* oΐ f^y
+		* @detail lƕΔDetail::pow_partialsŋ߂ipowlog2j
+		*         l^Zp^̏ꍇAw̔0Ȃpow(dual, )A̔0Ȃpow(, dual)ŋ߂
+		*/
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual<T>& f, const dual<T>& y) {
+			if constexpr (std::is_arithmetic<T>::value) {
+				if (y.b() == T(0.0)) return pow(f, y.a());
+				if (f.b() == T(0.0)) return pow(f.a(), y);
+			}
 
-			auto real = pow(f.a(), y.b());
-			auto dpow_y = y.a() * pow(f.a(), y.a() - T(1.0));
-			auto dpow_f = real * log(f.a());
-			return dual<T>{real, dpow_y * f.b() + dpow_f * y.b()};
+			const auto p = Detail::pow_partials(f.a(), y.a());
+			return dual<T>{ p[0], Detail::fma(p[1], f.b(), p[2] * y.b()) };
 		}
 
 		template<typename Exponent, typename T>
-		auto pow(Exponent f, const dual<T>& y) {
-			using std::pow;
-			using std::log;
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(Exponent f, const dual<T>& y) {
+			auto tmp = Detail::pow(f, y.a());
+			return dual<T>{tmp, y.b() * tmp * Detail::log(f)};
+		}
 
-			auto tmp = pow(f, y.a());
-			return dual<T>{tmp, y.b() * tmp * log(f)};
+		/**
+		* 
+		* @detail lx^ypow1񂾂߁A yEx^(y-1) Detail::pow_derivativeŒl狁߂
+		*         x^(y-1)l߂y-1̊ۂߌ덷lɓ̂ŁAl͒ڋ߂
+		*/
+		template<typename T, typename Exponent, std::enable_if_t<!std::is_integral<Exponent>::value, std::nullptr_t> = nullptr>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual<T>& d, Exponent y) {
+			const T value = Detail::pow(d.a(), y);
+			return dual<T>{value, d.b() * Detail::pow_derivative(d.a(), y, value)};
 		}
 
-		template<typename T, typename Exponent>
-		auto pow(const dual<T>& d, Exponent y) {
-			using std::pow;
-			return dual<T>{pow(d.a(), y), static_cast<T>(y)*d.b()*pow(d.a(), y - T(1.0))};
+		/**
+		* 
+		* @detail ̎w x^(n-1) i@ŋ߂Ēl xEx^(n-1) ƂA̎w r = 1/x l r^|n|  x^(n-1) = r^|n|Er ߂
+		*         0͒ɂ炸 {1, 0} Ƃi0̒1/x߂Ȃj
+		*          nEx^(n-1)AZ͍X1ŁAstd̊֐Ă΂Ȃ̂ŏɒ萔ŕ]ł
+		*/
+		template<typename T, typename Integer, std::enable_if_t<std::is_integral<Integer>::value, std::nullptr_t> = nullptr>
+		constexpr auto pow(const dual<T>& d, Integer n) {
+			const long long m = static_cast<long long>(n);
+
+			if (0 < m) {
+				const T previous = Detail::ipow(d.a(), static_cast<unsigned long long>(m - 1));
+				return dual<T>{d.a() * previous, static_cast<T>(m)*d.b()*previous};
+			}
+
+			if (m == 0) return dual<T>{T(1.0), T(0.0)};
+
+			const T r = T(1.0) / d.a();
+			const T value = Detail::ipow(r, 0ull - static_cast<unsigned long long>(m));
+			return dual<T>{value, static_cast<T>(m)*d.b()*(value * r)};
 		}
 
 		template<typename T>
-		auto hypot(const dual<T>&x, const dual<T>&y) {
-			using std::hypot;
-			auto diff = sqrt(x*x + y*y);
-			return dual<T>{hypot(x.a(), y.a()), diff.b()};
+		DUALNUMBER_CONSTEXPR_CMATH auto hypot(const dual<T>&x, const dual<T>&y) {
+			//hypot' = (xEx' + yEy')/hypot
+			const auto h = Detail::hypot(x.a(), y.a());
+			return dual<T>{h, Detail::fma(x.a(), x.b(), y.a() * y.b()) / h};
 		}
 
 		template<typename T>
-		auto sqrt(const dual<T>& d) {
-			using std::sqrt;
-			auto sqrt_a = sqrt(d.a());
+		DUALNUMBER_CONSTEXPR_CMATH auto sqrt(const dual<T>& d) {
+			auto sqrt_a = Detail::sqrt(d.a());
 			return dual<T>{sqrt_a, d.b() / (sqrt_a + sqrt_a)};
 		}
 
 		template<typename T>
-		auto cbrt(const dual<T>& d) {
-			using std::cbrt;
-			auto cbrt_a = cbrt(d.a());
-			cbrt_a *= cbrt_a;
-			return dual<T>{cbrt_a, d.b() / (cbrt_a + cbrt_a + cbrt_a)};
+		DUALNUMBER_CONSTEXPR_CMATH auto cbrt(const dual<T>& d) {
+			const auto cbrt_a = Detail::cbrt(d.a());
+			const auto cbrt_a2 = cbrt_a * cbrt_a;
+			return dual<T>{cbrt_a, d.b() / (cbrt_a2 + cbrt_a2 + cbrt_a2)};
 		}
 
+		/**
+		* sincos𓯎ɌvZ
+		* @brief ͈͏kƑ]1񂾂s
+		* @param d oΐ
+		* @return {sin(d), cos(d)}
+		*/
 		template<typename T>
-		auto sin(const dual<T>& d) {
-			using std::sin;
-			using std::cos;
+		DUALNUMBER_CONSTEXPR_CMATH auto sincos(const dual<T>& d) {
+			const auto sc = Detail::sincos(d.a());
 
-			return dual<T>{sin(d.a()), d.b()*cos(d.a())};
+			return std::pair<dual<T>, dual<T>>{ dual<T>{sc.first, d.b()*sc.second}, dual<T>{sc.second, -d.b()*sc.first} };
 		}
 
 		template<typename T>
-		auto cos(const dual<T>& d) {
-			using std::sin;
-			using std::cos;
-
-			return dual<T>{cos(d.a()), -d.b()*sin(d.a())};
+		DUALNUMBER_CONSTEXPR_CMATH auto sin(const dual<T>& d) {
+			const auto sc = Detail::sincos(d.a());
+			return dual<T>{sc.first, d.b()*sc.second};
 		}
 
 		template<typename T>
-		auto tan(const dual<T>& d) {
-			using std::cos;
-			using std::tan;
-
-			auto cos_a = cos(d.a());
-			return dual<T>{tan(d.a()), d.b() / (cos_a*cos_a)};
+		DUALNUMBER_CONSTEXPR_CMATH auto cos(const dual<T>& d) {
+			const auto sc = Detail::sincos(d.a());
+			return dual<T>{sc.second, -d.b()*sc.first};
 		}
 
 		template<typename T>
-		auto asin(const dual<T>& d) {
-			using std::asin;
-			using std::sqrt;
-
-			return dual<T>{asin(d.a()), d.b() / sqrt(T(1.0) -d.a()*d.a())};
+		DUALNUMBER_CONSTEXPR_CMATH auto tan(const dual<T>& d) {
+			//tan' = 1 + tan^2
+			auto f = Detail::tan(d.a());
+			return dual<T>{f, d.b() * Detail::fma(f, f, T(1.0))};
 		}
 
 		template<typename T>
-		auto acos(const dual<T>& d) {
-			using std::acos;
-			using std::sqrt;
-
-			return dual<T>{acos(d.a()), -d.b() / sqrt(T(1.0) -d.a()*d.a())};
+		DUALNUMBER_CONSTEXPR_CMATH auto asin(const dual<T>& d) {
+			return dual<T>{Detail::asin(d.a()), d.b() / Detail::sqrt(Detail::fma(-d.a(), d.a(), T(1.0)))};
 		}
 
 		template<typename T>
-		auto atan(const dual<T>& d) {
-			using std::atan;
-
-			return dual<T>{atan(d.a()), d.b() / (T(1.0) + d.a()*d.a())};
+		DUALNUMBER_CONSTEXPR_CMATH auto acos(const dual<T>& d) {
+			return dual<T>{Detail::acos(d.a()), -d.b() / Detail::sqrt(Detail::fma(-d.a(), d.a(), T(1.0)))};
 		}
 
 		template<typename T>
-		auto sinh(const dual<T>& d) {
-			using std::sinh;
-			using std::cosh;
-
-			return dual<T>{sinh(d.a()), d.b()* cosh(d.a()) };
+		DUALNUMBER_CONSTEXPR_CMATH auto atan(const dual<T>& d) {
+			return dual<T>{Detail::atan(d.a()), d.b() / Detail::fma(d.a(), d.a(), T(1.0))};
 		}
 
 		template<typename T>
-		auto cosh(const dual<T>& d) {
-			using std::sinh;
-			using std::cosh;
-
-			return dual<T>{cosh(d.a()), d.b()* sinh(d.a()) };
+		DUALNUMBER_CONSTEXPR_CMATH auto sinh(const dual<T>& d) {
+			return dual<T>{Detail::sinh(d.a()), d.b()* Detail::cosh(d.a()) };
 		}
 
 		template<typename T>
-		auto tanh(const dual<T>& d) {
-			using std::tanh;
-			using std::cosh;
-
-			auto cosh_a = cosh(d.a());
-			return dual<T>{tanh(d.a()), d.b() / (cosh_a*cosh_a)};
+		DUALNUMBER_CONSTEXPR_CMATH auto cosh(const dual<T>& d) {
+			return dual<T>{Detail::cosh(d.a()), d.b()* Detail::sinh(d.a()) };
 		}
 
 		template<typename T>
-		auto asinh(const dual<T>& d) {
-			using std::asinh;
-			using std::sqrt;
-
-			return dual<T>{asinh(d.a()), d.b() / sqrt(T(1.0) +d.a()*d.a())};
+		DUALNUMBER_CONSTEXPR_CMATH auto tanh(const dual<T>& d) {
+			//tanh' = 1 - tanh^2
+			auto f = Detail::tanh(d.a());
+			return dual<T>{f, d.b() * Detail::fma(-f, f, T(1.0))};
 		}
 
 		template<typename T>
-		auto acosh(const dual<T>& d) {
-			using std::acosh;
-			using std::sqrt;
-
-			return dual<T>{acosh(d.a()), d.b() / sqrt(d.a()*d.a() - T(1.0))};
+		DUALNUMBER_CONSTEXPR_CMATH auto asinh(const dual<T>& d) {
+			return dual<T>{Detail::asinh(d.a()), d.b() / Detail::sqrt(Detail::fma(d.a(), d.a(), T(1.0)))};
 		}
 
 		template<typename T>
-		auto atanh(const dual<T>& d) {
-			using std::atanh;
-
-			return dual<T>{atanh(d.a()), d.b() / (T(1.0) -d.a()*d.a())};
+		DUALNUMBER_CONSTEXPR_CMATH auto acosh(const dual<T>& d) {
+			//a^2 - 1  (a - 1)(a + 1) Ƃ邱Ƃ a  1 ł̌
+			return dual<T>{Detail::acosh(d.a()), d.b() / Detail::sqrt((d.a() - T(1.0)) * (d.a() + T(1.0)))};
 		}
 
 		template<typename T>
-		auto exp(const dual<T>& d) {
-			using std::exp;
+		DUALNUMBER_CONSTEXPR_CMATH auto atanh(const dual<T>& d) {
+			return dual<T>{Detail::atanh(d.a()), d.b() / ((T(1.0) - d.a()) * (T(1.0) + d.a()))};
+		}
 
-			auto f = exp(d.a());
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto exp(const dual<T>& d) {
+			auto f = Detail::exp(d.a());
 			return dual<T>{f, d.b()*f};
 		}
 
 		template<typename T>
-		auto exp2(const dual<T>& d) {
-			using std::exp2;
-
-			auto f = exp2(d.a());
+		DUALNUMBER_CONSTEXPR_CMATH auto exp2(const dual<T>& d) {
+			auto f = Detail::exp2(d.a());
 			return dual<T>{f, d.b()*f*Constant::loge_2<T>};
 		}
 
 		template<typename T>
-		auto expm1(const dual<T>& d) {
-			using std::exp;
-			using std::expm1;
+		DUALNUMBER_CONSTEXPR_CMATH auto expm1(const dual<T>& d) {
+			//expm1' = exp = expm1 + 1
+			auto f = Detail::expm1(d.a());
+			return dual<T>{f, d.b() * (f + T(1.0))};
+		}
 
-			return dual<T>{expm1(d.a()), d.b()*exp(d.a())};
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log(const dual<T>& d) {
+			return dual<T>{Detail::log(d.a()), d.b() / d.a()};
 		}
 
 		template<typename T>
-		auto log(const dual<T>& d) {
-			using std::log;
+		DUALNUMBER_CONSTEXPR_CMATH auto log1p(const dual<T>& d) {
+			return dual<T>{Detail::log1p(d.a()), d.b() / (T(1.0) + d.a())};
+		}
 
-			return dual<T>{log(d.a()), d.b() / d.a()};
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log10(const dual<T>& d) {
+			return dual<T>{Detail::log10(d.a()), d.b() / (d.a() * Constant::loge_10<T>)};
 		}
 
 		template<typename T>
-		auto log1p(const dual<T>& d) {
-			using std::log1p;
+		DUALNUMBER_CONSTEXPR_CMATH auto log2(const dual<T>& d) {
+			return dual<T>{Detail::log2(d.a()), d.b() / (d.a() * Constant::loge_2<T>)};
+		}
 
-			return dual<T>{log1p(d.a()), d.b() / (T(1.0) + d.a())};
+		/**
+		* Ϙa xEy + z
+		* @brief lfma(a_x, a_y, a_z)A a_xEb_y + b_xEa_y + b_z fma2ŋ߂
+		* @detail FMA߂gǂDUALNUMBER_USE_FMAiDetail::use_fmajɏ]
+		*/
+		template<typename T>
+		constexpr dual<T> fma(const dual<T>& x, const dual<T>& y, const dual<T>& z) {
+			return dual<T>{ Detail::fma(x.a(), y.a(), z.a()), Detail::fma(x.a(), y.b(), Detail::fma(x.b(), y.a(), z.b())) };
 		}
 
+		/**
+		* Horner@ŕ]
+		* @brief p(x) = c[0]Ex^(n-1) + c[1]Ex^(n-2) + ... + c[n-1]AW͎̍
+		* @detail l p  pEx + c Ɣ p'  p'Ex + pEx' ꂼfmaōXV̂ŁA1̉Zfma2ƏZ1
+		*         FMA߂gǂDUALNUMBER_USE_FMAiDetail::use_fmajɏ]
+		* @param coeffs W̔z
+		* @param count W̐
+		* @param x oΐ
+		* @return {p(x), p'(x)Ex.b()}
+		*/
 		template<typename T>
-		auto log10(const dual<T>& d) {
-			using std::log10;
+		constexpr dual<T> polyval(const T* coeffs, std::size_t count, const dual<T>& x) {
+			if (count == 0) return dual<T>{};
+
+			T a = coeffs[0];
+			T b = T(0.0);
+			for (std::size_t k = 1; k < count; ++k) {
+				b = Detail::fma(b, x.a(), a * x.b());
+				a = Detail::fma(a, x.a(), coeffs[k]);
+			}
+			return dual<T>{a, b};
+		}
 
-			return dual<T>{log10(d.a()), d.b() / (d.a() * Constant::loge_10<T>)};
+		template<typename T, std::size_t N>
+		constexpr dual<T> polyval(const std::array<T, N>& coeffs, const dual<T>& x) {
+			return polyval(coeffs.data(), N, x);
 		}
 
 		template<typename T>
-		auto log2(const dual<T>& d) {
-			using std::log10;
-
-			return dual<T>{log2(d.a()), d.b() / (d.a() * Constant::loge_2<T>)};
+		constexpr dual<T> polyval(std::initializer_list<T> coeffs, const dual<T>& x) {
+			return polyval(coeffs.begin(), coeffs.size(), x);
 		}
 
 #if 201603L <= __cpp_lib_math_special_functions
@@ -624,7 +1579,7 @@ namespace DualNumbers {
 
 			if (nu == T{ 0.0 }) {
 				// Z0'(x) = -Z1(x)AZ=Cӂ̉~֐ixbZAmC}AnPj
-				return dual<ReturnType>{bessel(T(0.0), x.a()), -x.b() * bessel(T(0.0), x.a())};
+				return dual<ReturnType>{bessel(T(0.0), x.a()), -x.b() * bessel(T(1.0), x.a())};
 			}
 			else {
 				// Zn'(x) = 0.5*(Zn-1(x) - Zn+1(x))
@@ -740,7 +1695,7 @@ namespace DualNumbers {
 		* @param nu e~֐̃(v)
 		* @param x ͑oΐ
 		*/
-		auto cyl_hankel_1f(float nu, const dual<float>& x) {
+		inline auto cyl_hankel_1f(float nu, const dual<float>& x) {
 			return calculateBesselFunctions(nu, x, [](auto nu, auto x) {return std::complex<float>{std::cyl_bessel_jf(nu, x), std::cyl_neumannf(nu, x) }; });
 		}
 
@@ -750,7 +1705,7 @@ namespace DualNumbers {
 		* @param nu e~֐̃(v)
 		* @param x ͑oΐ
 		*/
-		auto cyl_hankel_2f(float nu, const dual<float>& x) {
+		inline auto cyl_hankel_2f(float nu, const dual<float>& x) {
 			return calculateBesselFunctions(nu, x, [](auto nu, auto x) {return std::complex<float>{std::cyl_bessel_jf(nu, x), -std::cyl_neumannf(nu, x) }; });
 		}
 
@@ -760,7 +1715,7 @@ namespace DualNumbers {
 		* @param nu e~֐̃(v)
 		* @param x ͑oΐ
 		*/
-		auto cyl_hankel_1(double nu, const dual<double>& x) {
+		inline auto cyl_hankel_1(double nu, const dual<double>& x) {
 			return calculateBesselFunctions(nu, x, [](auto nu, auto x) {return std::complex<double>{std::cyl_bessel_j(nu, x), std::cyl_neumann(nu, x) }; });
 		}
 
@@ -770,7 +1725,7 @@ namespace DualNumbers {
 		* @param nu e~֐̃(v)
 		* @param x ͑oΐ
 		*/
-		auto cyl_hankel_2(double nu, const dual<double>& x) {
+		inline auto cyl_hankel_2(double nu, const dual<double>& x) {
 			return calculateBesselFunctions(nu, x, [](auto nu, auto x) {return std::complex<double>{std::cyl_bessel_j(nu, x), -std::cyl_neumann(nu, x) }; });
 		}
 
@@ -780,7 +1735,7 @@ namespace DualNumbers {
 		* @param nu e~֐̃(v)
 		* @param x ͑oΐ
 		*/
-		auto cyl_hankel_1l(long double nu, const dual<long double>& x) {
+		inline auto cyl_hankel_1l(long double nu, const dual<long double>& x) {
 			return calculateBesselFunctions(nu, x, [](auto nu, auto x) {return std::complex<long double>{std::cyl_bessel_jl(nu, x), std::cyl_neumannl(nu, x) }; });
 		}
 
@@ -790,7 +1745,7 @@ namespace DualNumbers {
 		* @param nu e~֐̃(v)
 		* @param x ͑oΐ
 		*/
-		auto cyl_hankel_2l(long double nu, const dual<long double>& x) {
+		inline auto cyl_hankel_2l(long double nu, const dual<long double>& x) {
 			return calculateBesselFunctions(nu, x, [](auto nu, auto x) {return std::complex<long double>{std::cyl_bessel_jl(nu, x), -std::cyl_neumannl(nu, x) }; });
 		}
 
@@ -875,6 +1830,201 @@ namespace DualNumbers {
 			return dual<T>{d.a(), -d.b()};
 		}
 
+		namespace Detail {
+
+			/**
+			* 3Q̑傫牺ɉiAό`xbZ֐pj
+			* @detail Z(n-1) = (2n/x)Z(n) - Z(n+1)AJ( = 1)I( = -1)͂̌Ɉ
+			* @param nu ŏ̎
+			* @param orders ̐i1ȏAJ֐0j
+			* @param x ij
+			* @param sigma Q̕
+			* @param bessel N_2̎vZ֐
+			* @param z orders + 1̏óAz[k] = Z(nu + k)
+			*/
+			template<typename T, typename BesselFunctor>
+			void besselRecurrenceDownward(T nu, std::size_t orders, T x, T sigma, BesselFunctor&& bessel, T* z) {
+				z[orders] = bessel(nu + T(orders), x);
+				z[orders - 1] = bessel(nu + T(orders - 1), x);
+
+				for (std::size_t k = orders - 1; k-- > 0;) {
+					const T n = nu + T(k + 1);
+					z[k] = T(2.0) * n / x * z[k + 1] - sigma * z[k + 2];
+				}
+			}
+
+			/**
+			* 3Q̏ɉiAό`xbZ֐pj
+			* @detail Z(n+1) = (2n/x)Z(n) - Z(n-1)AY( = 1)K( = -1)͂̌Ɉ
+			* @param nu ŏ̎
+			* @param orders ̐i1ȏAJ֐0j
+			* @param x ij
+			* @param sigma Q̕
+			* @param bessel N_2̎vZ֐
+			* @param z orders + 1̏óAz[k] = Z(nu + k)
+			*/
+			template<typename T, typename BesselFunctor>
+			void besselRecurrenceUpward(T nu, std::size_t orders, T x, T sigma, BesselFunctor&& bessel, T* z) {
+				z[0] = bessel(nu, x);
+				z[1] = bessel(nu + T(1.0), x);
+
+				for (std::size_t k = 1; k < orders; ++k) {
+					const T n = nu + T(k);
+					z[k + 1] = T(2.0) * n / x * z[k] - sigma * z[k - 1];
+				}
+			}
+
+			/**
+			* Qŋ߂loΐ
+			* @detail Z'(n) = (n/x)Z(n) - Z(n+1)AJ, Y, K̓ = 1AI̓ = -1
+			* @param result orders̏o
+			*/
+			template<typename T, typename V>
+			void besselDuals(T nu, std::size_t orders, const dual<T>& x, T tau, const V* z, dual<V>* result) {
+				for (std::size_t k = 0; k < orders; ++k) {
+					const T n_x = (nu + T(k)) / x.a();
+					result[k] = dual<V>{ z[k], x.b() * (n_x * z[k] - tau * z[k + 1]) };
+				}
+			}
+
+			template<typename T>
+			using identity_t = typename dual<T>::value_type;
+		}
+
+		/**
+		* A鎟̑xbZ֐܂Ƃ߂ČvZ
+		* @brief 1_̓֐̌Ăяo͎̐ɂ炸2Ac͉̑Qŋ߂
+		* @param nu ŏ̎Anu, nu + 1, ..., nu + orders - 1 vZ
+		* @param orders ̐A0Ȃ牽Ȃ
+		* @param x points̓͑oΐA͐ł邱
+		* @param points ͂̐
+		* @param result points * orders̏óAresult[p * orders + k] = J(nu + k, x[p])
+		*/
+		template<typename T>
+		void cyl_bessel_j_batch(Detail::identity_t<T> nu, std::size_t orders, const dual<T>* x, std::size_t points, dual<T>* result) {
+			using std::cyl_bessel_j;
+
+			if (orders == 0) return;
+
+			std::vector<T> z(orders + 1);
+			for (std::size_t p = 0; p < points; ++p) {
+				Detail::besselRecurrenceDownward(nu, orders, x[p].a(), T(1.0), [](auto nu, auto x) {return cyl_bessel_j(nu, x); }, z.data());
+				Detail::besselDuals(nu, orders, x[p], T(1.0), z.data(), result + p * orders);
+			}
+		}
+
+		/**
+		* A鎟̑xbZ֐(mC}֐)܂Ƃ߂ČvZ
+		* @brief 1_̓֐̌Ăяo͎̐ɂ炸2Ac͏̑Qŋ߂
+		* @param nu ŏ̎Anu, nu + 1, ..., nu + orders - 1 vZ
+		* @param orders ̐A0Ȃ牽Ȃ
+		* @param x points̓͑oΐA͐ł邱
+		* @param points ͂̐
+		* @param result points * orders̏óAresult[p * orders + k] = Y(nu + k, x[p])
+		*/
+		template<typename T>
+		void cyl_neumann_batch(Detail::identity_t<T> nu, std::size_t orders, const dual<T>* x, std::size_t points, dual<T>* result) {
+			using std::cyl_neumann;
+
+			if (orders == 0) return;
+
+			std::vector<T> z(orders + 1);
+			for (std::size_t p = 0; p < points; ++p) {
+				Detail::besselRecurrenceUpward(nu, orders, x[p].a(), T(1.0), [](auto nu, auto x) {return cyl_neumann(nu, x); }, z.data());
+				Detail::besselDuals(nu, orders, x[p], T(1.0), z.data(), result + p * orders);
+			}
+		}
+
+		/**
+		* A鎟̑OxbZ֐(nP֐A̕vX)܂Ƃ߂ČvZ
+		* @brief 1_̓֐̌ĂяoJY2񂸂Ac͂ꂼȌ̑Qŋ߂
+		* @param result points * orders̏óAresult[p * orders + k] = H1(nu + k, x[p])
+		*/
+		template<typename T>
+		void cyl_hankel_1_batch(Detail::identity_t<T> nu, std::size_t orders, const dual<T>* x, std::size_t points, dual<std::complex<T>>* result) {
+			using std::cyl_bessel_j;
+			using std::cyl_neumann;
+
+			if (orders == 0) return;
+
+			std::vector<T> j(orders + 1);
+			std::vector<T> y(orders + 1);
+			std::vector<std::complex<T>> z(orders + 1);
+			for (std::size_t p = 0; p < points; ++p) {
+				Detail::besselRecurrenceDownward(nu, orders, x[p].a(), T(1.0), [](auto nu, auto x) {return cyl_bessel_j(nu, x); }, j.data());
+				Detail::besselRecurrenceUpward(nu, orders, x[p].a(), T(1.0), [](auto nu, auto x) {return cyl_neumann(nu, x); }, y.data());
+				for (std::size_t k = 0; k <= orders; ++k) z[k] = std::complex<T>{ j[k], y[k] };
+				Detail::besselDuals(nu, orders, x[p], T(1.0), z.data(), result + p * orders);
+			}
+		}
+
+		/**
+		* A鎟̑OxbZ֐(nP֐A̕}CiX)܂Ƃ߂ČvZ
+		* @brief 1_̓֐̌ĂяoJY2񂸂Ac͂ꂼȌ̑Qŋ߂
+		* @param result points * orders̏óAresult[p * orders + k] = H2(nu + k, x[p])
+		*/
+		template<typename T>
+		void cyl_hankel_2_batch(Detail::identity_t<T> nu, std::size_t orders, const dual<T>* x, std::size_t points, dual<std::complex<T>>* result) {
+			using std::cyl_bessel_j;
+			using std::cyl_neumann;
+
+			if (orders == 0) return;
+
+			std::vector<T> j(orders + 1);
+			std::vector<T> y(orders + 1);
+			std::vector<std::complex<T>> z(orders + 1);
+			for (std::size_t p = 0; p < points; ++p) {
+				Detail::besselRecurrenceDownward(nu, orders, x[p].a(), T(1.0), [](auto nu, auto x) {return cyl_bessel_j(nu, x); }, j.data());
+				Detail::besselRecurrenceUpward(nu, orders, x[p].a(), T(1.0), [](auto nu, auto x) {return cyl_neumann(nu, x); }, y.data());
+				for (std::size_t k = 0; k <= orders; ++k) z[k] = std::complex<T>{ j[k], -y[k] };
+				Detail::besselDuals(nu, orders, x[p], T(1.0), z.data(), result + p * orders);
+			}
+		}
+
+		/**
+		* A鎟̑ό`xbZ֐܂Ƃ߂ČvZ
+		* @brief 1_̓֐̌Ăяo͎̐ɂ炸2Ac͉̑Qŋ߂
+		* @param nu ŏ̎Anu, nu + 1, ..., nu + orders - 1 vZ
+		* @param orders ̐A0Ȃ牽Ȃ
+		* @param x points̓͑oΐA͐ł邱
+		* @param points ͂̐
+		* @param result points * orders̏óAresult[p * orders + k] = I(nu + k, x[p])
+		*/
+		template<typename T>
+		void cyl_bessel_i_batch(Detail::identity_t<T> nu, std::size_t orders, const dual<T>* x, std::size_t points, dual<T>* result) {
+			using std::cyl_bessel_i;
+
+			if (orders == 0) return;
+
+			std::vector<T> z(orders + 1);
+			for (std::size_t p = 0; p < points; ++p) {
+				Detail::besselRecurrenceDownward(nu, orders, x[p].a(), T(-1.0), [](auto nu, auto x) {return cyl_bessel_i(nu, x); }, z.data());
+				Detail::besselDuals(nu, orders, x[p], T(-1.0), z.data(), result + p * orders);
+			}
+		}
+
+		/**
+		* A鎟̑ό`xbZ֐܂Ƃ߂ČvZ
+		* @brief 1_̓֐̌Ăяo͎̐ɂ炸2Ac͏̑Qŋ߂
+		* @param nu ŏ̎Anu, nu + 1, ..., nu + orders - 1 vZ
+		* @param orders ̐A0Ȃ牽Ȃ
+		* @param x points̓͑oΐA͐ł邱
+		* @param points ͂̐
+		* @param result points * orders̏óAresult[p * orders + k] = K(nu + k, x[p])
+		*/
+		template<typename T>
+		void cyl_bessel_k_batch(Detail::identity_t<T> nu, std::size_t orders, const dual<T>* x, std::size_t points, dual<T>* result) {
+			using std::cyl_bessel_k;
+
+			if (orders == 0) return;
+
+			std::vector<T> z(orders + 1);
+			for (std::size_t p = 0; p < points; ++p) {
+				Detail::besselRecurrenceUpward(nu, orders, x[p].a(), T(-1.0), [](auto nu, auto x) {return cyl_bessel_k(nu, x); }, z.data());
+				Detail::besselDuals(nu, orders, x[p], T(1.0), z.data(), result + p * orders);
+			}
+		}
+
 #endif // __cpp_lib_math_special_functions
 
 	}
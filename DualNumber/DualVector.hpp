@@ -0,0 +1,1098 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <initializer_list>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief dual_vectorの要素を参照するプロキシ
+	* @detail dual<T>と同じように読み書きできる、実体は実部・虚部それぞれの配列の要素を指す
+	* @tparam T 値型
+	*/
+	template<typename T>
+	struct dual_reference {
+		using this_type  = dual_reference<T>;
+		using value_type = T;
+
+		constexpr dual_reference(T& a, T& b)
+			: m_a{ a }
+			, m_b{ b }
+		{}
+
+		constexpr dual_reference(const this_type& other) = default;
+
+		/**
+		* 参照先の値を書き換える
+		* @brief プロキシ自体ではなく参照先の要素に代入する
+		*/
+		constexpr this_type& operator=(const this_type& rhs) {
+			m_a = rhs.m_a;
+			m_b = rhs.m_b;
+
+			return *this;
+		}
+
+		constexpr this_type& operator=(const dual<T>& rhs) {
+			m_a = rhs.a();
+			m_b = rhs.b();
+
+			return *this;
+		}
+
+		constexpr operator dual<T>() const {
+			return dual<T>{ m_a, m_b };
+		}
+
+		constexpr dual<T> operator+() const {
+			return dual<T>{ m_a, m_b };
+		}
+
+		constexpr dual<T> operator-() const {
+			return dual<T>{ -m_a, -m_b };
+		}
+
+		constexpr this_type& operator+=(const dual<T>& rhs) {
+			return *this = dual<T>{ *this } += rhs;
+		}
+
+		constexpr this_type& operator+=(const T rhs) {
+			return *this = dual<T>{ *this } += rhs;
+		}
+
+		constexpr this_type& operator-=(const dual<T>& rhs) {
+			return *this = dual<T>{ *this } -= rhs;
+		}
+
+		constexpr this_type& operator-=(const T rhs) {
+			return *this = dual<T>{ *this } -= rhs;
+		}
+
+		constexpr this_type& operator*=(const dual<T>& rhs) {
+			return *this = dual<T>{ *this } *= rhs;
+		}
+
+		constexpr this_type& operator*=(const T rhs) {
+			return *this = dual<T>{ *this } *= rhs;
+		}
+
+		constexpr this_type& operator/=(const dual<T>& rhs) {
+			return *this = dual<T>{ *this } /= rhs;
+		}
+
+		constexpr this_type& operator/=(const T rhs) {
+			return *this = dual<T>{ *this } /= rhs;
+		}
+
+		/**
+		* 実部を取得する
+		* @return 実部の値
+		*/
+		constexpr T a() const {
+			return m_a;
+		}
+
+		/**
+		* 虚部を取得する
+		* @return 虚部の値
+		*/
+		constexpr T b() const {
+			return m_b;
+		}
+
+	private:
+		T& m_a;
+		T& m_b;
+	};
+
+	template<typename T>
+	std::ostream& operator<<(std::ostream& ostream, const dual_reference<T>& rhs) {
+		return ostream << dual<T>{ rhs };
+	}
+
+	//dual_referenceとの演算はdual<T>として行う、結果はdual<T>
+
+	template<typename T>
+	constexpr auto operator+(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } + dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator+(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } + rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator+(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs + dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator+(const dual_reference<T>& lhs, const T rhs) {
+		return dual<T>{ lhs } + rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator+(const T lhs, const dual_reference<T>& rhs) {
+		return lhs + dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator-(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } - dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator-(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } - rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs - dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator-(const dual_reference<T>& lhs, const T rhs) {
+		return dual<T>{ lhs } - rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const T lhs, const dual_reference<T>& rhs) {
+		return lhs - dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator*(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } * dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator*(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } * rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs * dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator*(const dual_reference<T>& lhs, const T rhs) {
+		return dual<T>{ lhs } * rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const T lhs, const dual_reference<T>& rhs) {
+		return lhs * dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator/(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } / dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator/(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } / rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs / dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator/(const dual_reference<T>& lhs, const T rhs) {
+		return dual<T>{ lhs } / rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const T lhs, const dual_reference<T>& rhs) {
+		return lhs / dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator==(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } == dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator==(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } == rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator==(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs == dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator!=(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } != dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator!=(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } != rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator!=(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs != dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator<(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } < dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator<(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } < rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator<(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs < dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator<=(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } <= dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator<=(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } <= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator<=(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs <= dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator>(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } > dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator>(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } > rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator>(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs > dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator>=(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+		return dual<T>{ lhs } >= dual<T>{ rhs };
+	}
+
+	template<typename T>
+	constexpr auto operator>=(const dual_reference<T>& lhs, const dual<T>& rhs) {
+		return dual<T>{ lhs } >= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator>=(const dual<T>& lhs, const dual_reference<T>& rhs) {
+		return lhs >= dual<T>{ rhs };
+	}
+
+	inline namespace cmath {
+
+		//dual_referenceは関数テンプレートの推論で変換されないので、dual<T>にして呼ぶ
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sqrt(const dual_reference<T>& d) {
+			return sqrt(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto cbrt(const dual_reference<T>& d) {
+			return cbrt(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sin(const dual_reference<T>& d) {
+			return sin(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto cos(const dual_reference<T>& d) {
+			return cos(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sincos(const dual_reference<T>& d) {
+			return sincos(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto tan(const dual_reference<T>& d) {
+			return tan(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto asin(const dual_reference<T>& d) {
+			return asin(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto acos(const dual_reference<T>& d) {
+			return acos(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atan(const dual_reference<T>& d) {
+			return atan(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto sinh(const dual_reference<T>& d) {
+			return sinh(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto cosh(const dual_reference<T>& d) {
+			return cosh(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto tanh(const dual_reference<T>& d) {
+			return tanh(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto asinh(const dual_reference<T>& d) {
+			return asinh(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto acosh(const dual_reference<T>& d) {
+			return acosh(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atanh(const dual_reference<T>& d) {
+			return atanh(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto exp(const dual_reference<T>& d) {
+			return exp(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto exp2(const dual_reference<T>& d) {
+			return exp2(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto expm1(const dual_reference<T>& d) {
+			return expm1(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log(const dual_reference<T>& d) {
+			return log(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log1p(const dual_reference<T>& d) {
+			return log1p(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log10(const dual_reference<T>& d) {
+			return log10(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto log2(const dual_reference<T>& d) {
+			return log2(dual<T>{ d });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atan2(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+			return atan2(dual<T>{ lhs }, dual<T>{ rhs });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atan2(const dual_reference<T>& lhs, const dual<T>& rhs) {
+			return atan2(dual<T>{ lhs }, rhs);
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto atan2(const dual<T>& lhs, const dual_reference<T>& rhs) {
+			return atan2(lhs, dual<T>{ rhs });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+			return pow(dual<T>{ lhs }, dual<T>{ rhs });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual_reference<T>& lhs, const dual<T>& rhs) {
+			return pow(dual<T>{ lhs }, rhs);
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual<T>& lhs, const dual_reference<T>& rhs) {
+			return pow(lhs, dual<T>{ rhs });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto hypot(const dual_reference<T>& lhs, const dual_reference<T>& rhs) {
+			return hypot(dual<T>{ lhs }, dual<T>{ rhs });
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto hypot(const dual_reference<T>& lhs, const dual<T>& rhs) {
+			return hypot(dual<T>{ lhs }, rhs);
+		}
+
+		template<typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto hypot(const dual<T>& lhs, const dual_reference<T>& rhs) {
+			return hypot(lhs, dual<T>{ rhs });
+		}
+
+		template<typename T, typename Exponent>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(const dual_reference<T>& d, Exponent y) {
+			return pow(dual<T>{ d }, y);
+		}
+
+		template<typename Exponent, typename T>
+		DUALNUMBER_CONSTEXPR_CMATH auto pow(Exponent f, const dual_reference<T>& y) {
+			return pow(f, dual<T>{ y });
+		}
+	}
+
+	/**
+	* @brief 双対数の配列、SoAレイアウト
+	* @detail 実部と虚部をそれぞれ連続した配列に保持する、一括演算はそれぞれの配列上の単純なループになりベクトル化しやすい
+	* @tparam T 値型
+	*/
+	template<typename T>
+	class dual_vector {
+	public:
+		using this_type       = dual_vector<T>;
+		using value_type      = dual<T>;
+		using reference       = dual_reference<T>;
+		using const_reference = dual<T>;
+		using size_type       = std::size_t;
+
+		dual_vector() = default;
+
+		/**
+		* 要素数を指定して構築する
+		* @param count 要素数
+		* @param value 各要素の初期値
+		*/
+		explicit dual_vector(size_type count, const dual<T>& value = dual<T>{})
+			: m_a(count, value.a())
+			, m_b(count, value.b())
+		{}
+
+		dual_vector(std::initializer_list<dual<T>> init) {
+			reserve(init.size());
+			for (const auto& d : init) {
+				push_back(d);
+			}
+		}
+
+		size_type size() const noexcept {
+			return m_a.size();
+		}
+
+		bool empty() const noexcept {
+			return m_a.empty();
+		}
+
+		void reserve(size_type capacity) {
+			m_a.reserve(capacity);
+			m_b.reserve(capacity);
+		}
+
+		void resize(size_type count, const dual<T>& value = dual<T>{}) {
+			m_a.resize(count, value.a());
+			m_b.resize(count, value.b());
+		}
+
+		void clear() noexcept {
+			m_a.clear();
+			m_b.clear();
+		}
+
+		void push_back(const dual<T>& value) {
+			m_a.push_back(value.a());
+			m_b.push_back(value.b());
+		}
+
+		reference operator[](size_type index) {
+			return reference{ m_a[index], m_b[index] };
+		}
+
+		const_reference operator[](size_type index) const {
+			return const_reference{ m_a[index], m_b[index] };
+		}
+
+		/**
+		* 実部の配列の先頭を得る
+		* @return 連続したsize()個の実部
+		*/
+		T* a_data() noexcept {
+			return m_a.data();
+		}
+
+		const T* a_data() const noexcept {
+			return m_a.data();
+		}
+
+		/**
+		* 虚部の配列の先頭を得る
+		* @return 連続したsize()個の虚部
+		*/
+		T* b_data() noexcept {
+			return m_b.data();
+		}
+
+		const T* b_data() const noexcept {
+			return m_b.data();
+		}
+
+		/**
+		* 要素毎に加算する
+		* @detail 要素数が等しいこと
+		*/
+		this_type& operator+=(const this_type& rhs) {
+			T* a = m_a.data();
+			T* b = m_b.data();
+			const T* ra = rhs.m_a.data();
+			const T* rb = rhs.m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] += ra[i];
+				b[i] += rb[i];
+			}
+
+			return *this;
+		}
+
+		this_type& operator+=(const dual<T>& rhs) {
+			const T ra = rhs.a();
+			const T rb = rhs.b();
+			T* a = m_a.data();
+			T* b = m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] += ra;
+				b[i] += rb;
+			}
+
+			return *this;
+		}
+
+		this_type& operator+=(const T rhs) {
+			T* a = m_a.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] += rhs;
+			}
+
+			return *this;
+		}
+
+		/**
+		* 要素毎に減算する
+		* @detail 要素数が等しいこと
+		*/
+		this_type& operator-=(const this_type& rhs) {
+			T* a = m_a.data();
+			T* b = m_b.data();
+			const T* ra = rhs.m_a.data();
+			const T* rb = rhs.m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] -= ra[i];
+				b[i] -= rb[i];
+			}
+
+			return *this;
+		}
+
+		this_type& operator-=(const dual<T>& rhs) {
+			const T ra = rhs.a();
+			const T rb = rhs.b();
+			T* a = m_a.data();
+			T* b = m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] -= ra;
+				b[i] -= rb;
+			}
+
+			return *this;
+		}
+
+		this_type& operator-=(const T rhs) {
+			T* a = m_a.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] -= rhs;
+			}
+
+			return *this;
+		}
+
+		/**
+		* 要素毎に乗算する
+		* @detail 要素数が等しいこと
+		*/
+		this_type& operator*=(const this_type& rhs) {
+			T* a = m_a.data();
+			T* b = m_b.data();
+			const T* ra = rhs.m_a.data();
+			const T* rb = rhs.m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				//(a+bε)*(c+dε) = ac + (ad + bc)ε
+				b[i] = Detail::fma(b[i], ra[i], a[i] * rb[i]);
+				a[i] *= ra[i];
+			}
+
+			return *this;
+		}
+
+		this_type& operator*=(const dual<T>& rhs) {
+			const T ra = rhs.a();
+			const T rb = rhs.b();
+			T* a = m_a.data();
+			T* b = m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				b[i] = Detail::fma(b[i], ra, a[i] * rb);
+				a[i] *= ra;
+			}
+
+			return *this;
+		}
+
+		this_type& operator*=(const T rhs) {
+			T* a = m_a.data();
+			T* b = m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] *= rhs;
+				b[i] *= rhs;
+			}
+
+			return *this;
+		}
+
+		/**
+		* 要素毎に除算する
+		* @detail 要素数が等しく、除数の実部(a)がゼロでないこと
+		*/
+		this_type& operator/=(const this_type& rhs) {
+			T* a = m_a.data();
+			T* b = m_b.data();
+			const T* ra = rhs.m_a.data();
+			const T* rb = rhs.m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				// (a+bε)/(c+dε) = q + (b - qd)ε/c、q = a/c
+				//dualの除算と同じく、除算は逆数の1回だけにして値はDetail::quotientで補正する
+				const T r = T(1.0) / ra[i];
+				const T q = Detail::quotient(a[i], ra[i], r);
+				b[i] = Detail::fma(-q, rb[i], b[i]) * r;
+				a[i] = q;
+			}
+
+			return *this;
+		}
+
+		this_type& operator/=(const dual<T>& rhs) {
+			const T r = T(1.0) / rhs.a();
+			const T rb = rhs.b();
+			T* a = m_a.data();
+			T* b = m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				const T q = Detail::quotient(a[i], rhs.a(), r);
+				b[i] = Detail::fma(-q, rb, b[i]) * r;
+				a[i] = q;
+			}
+
+			return *this;
+		}
+
+		this_type& operator/=(const T rhs) {
+			T* a = m_a.data();
+			T* b = m_b.data();
+
+			for (size_type i = 0; i < size(); ++i) {
+				a[i] /= rhs;
+				b[i] /= rhs;
+			}
+
+			return *this;
+		}
+
+		this_type operator-() const {
+			this_type result(*this);
+			result *= T(-1.0);
+			return result;
+		}
+
+	private:
+		std::vector<T> m_a;
+		std::vector<T> m_b;
+	};
+
+
+	template<typename T>
+	auto operator+(const dual_vector<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result += rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator+(const dual_vector<T>& lhs, const dual<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result += rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator+(const dual<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(rhs);
+		result += lhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator+(const dual_vector<T>& lhs, const T rhs) {
+		dual_vector<T> result(lhs);
+		result += rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator+(const T lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(rhs);
+		result += lhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator-(const dual_vector<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result -= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator-(const dual_vector<T>& lhs, const dual<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result -= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator-(const dual<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result = -rhs;
+		result += lhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator-(const dual_vector<T>& lhs, const T rhs) {
+		dual_vector<T> result(lhs);
+		result -= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator-(const T lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result = -rhs;
+		result += lhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator*(const dual_vector<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result *= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator*(const dual_vector<T>& lhs, const dual<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result *= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator*(const dual<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(rhs);
+		result *= lhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator*(const dual_vector<T>& lhs, const T rhs) {
+		dual_vector<T> result(lhs);
+		result *= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator*(const T lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(rhs);
+		result *= lhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator/(const dual_vector<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result /= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator/(const dual_vector<T>& lhs, const dual<T>& rhs) {
+		dual_vector<T> result(lhs);
+		result /= rhs;
+		return result;
+	}
+
+	template<typename T>
+	auto operator/(const dual_vector<T>& lhs, const T rhs) {
+		dual_vector<T> result(lhs);
+		result /= rhs;
+		return result;
+	}
+
+	/**
+	* 双対数を要素毎に割る
+	* @detail 除数の実部(a)がゼロでないこと
+	*/
+	template<typename T>
+	auto operator/(const dual<T>& lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(rhs.size());
+
+		const T la = lhs.a();
+		const T lb = lhs.b();
+		const T* ra = rhs.a_data();
+		const T* rb = rhs.b_data();
+		T* a = result.a_data();
+		T* b = result.b_data();
+
+		for (std::size_t i = 0; i < rhs.size(); ++i) {
+			const T r = T(1.0) / ra[i];
+			const T q = Detail::quotient(la, ra[i], r);
+			a[i] = q;
+			b[i] = Detail::fma(-q, rb[i], lb) * r;
+		}
+
+		return result;
+	}
+
+	/**
+	* スカラーを要素毎に割る
+	* @detail 除数の実部(a)がゼロでないこと
+	*/
+	template<typename T>
+	auto operator/(const T lhs, const dual_vector<T>& rhs) {
+		dual_vector<T> result(rhs.size());
+
+		const T* ra = rhs.a_data();
+		const T* rb = rhs.b_data();
+		T* a = result.a_data();
+		T* b = result.b_data();
+
+		for (std::size_t i = 0; i < rhs.size(); ++i) {
+			const T r = T(1.0) / ra[i];
+			const T q = Detail::quotient(lhs, ra[i], r);
+			a[i] = q;
+			b[i] = -q * rb[i] * r;
+		}
+
+		return result;
+	}
+
+	inline namespace cmath {
+
+		/**
+		* 全要素に関数を適用する
+		* @brief 双対数を受け取る任意の関数を要素毎に適用し、結果をSoAで保持する
+		* @detail fがインライン展開されれば実部・虚部の配列上のループとしてベクトル化される
+		* @param v 入力配列
+		* @param f dual<T>を受けてdual<T>を返す関数
+		* @return 要素毎にfを適用した結果
+		*/
+		template<typename T, typename Func>
+		dual_vector<T> transform(const dual_vector<T>& v, Func&& f) {
+			dual_vector<T> result(v.size());
+
+			const T* a = v.a_data();
+			const T* b = v.b_data();
+			T* ra = result.a_data();
+			T* rb = result.b_data();
+
+			for (std::size_t i = 0; i < v.size(); ++i) {
+				const dual<T> d = f(dual<T>{ a[i], b[i] });
+				ra[i] = d.a();
+				rb[i] = d.b();
+			}
+
+			return result;
+		}
+
+		template<typename T>
+		auto sqrt(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return sqrt(d); });
+		}
+
+		template<typename T>
+		auto cbrt(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return cbrt(d); });
+		}
+
+		template<typename T>
+		auto sin(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return sin(d); });
+		}
+
+		template<typename T>
+		auto cos(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return cos(d); });
+		}
+
+		template<typename T>
+		auto tan(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return tan(d); });
+		}
+
+		template<typename T>
+		auto asin(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return asin(d); });
+		}
+
+		template<typename T>
+		auto acos(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return acos(d); });
+		}
+
+		template<typename T>
+		auto atan(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return atan(d); });
+		}
+
+		template<typename T>
+		auto sinh(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return sinh(d); });
+		}
+
+		template<typename T>
+		auto cosh(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return cosh(d); });
+		}
+
+		template<typename T>
+		auto tanh(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return tanh(d); });
+		}
+
+		template<typename T>
+		auto asinh(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return asinh(d); });
+		}
+
+		template<typename T>
+		auto acosh(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return acosh(d); });
+		}
+
+		template<typename T>
+		auto atanh(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return atanh(d); });
+		}
+
+		template<typename T>
+		auto exp(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return exp(d); });
+		}
+
+		template<typename T>
+		auto exp2(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return exp2(d); });
+		}
+
+		template<typename T>
+		auto expm1(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return expm1(d); });
+		}
+
+		template<typename T>
+		auto log(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return log(d); });
+		}
+
+		template<typename T>
+		auto log1p(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return log1p(d); });
+		}
+
+		template<typename T>
+		auto log10(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return log10(d); });
+		}
+
+		template<typename T>
+		auto log2(const dual_vector<T>& v) {
+			return transform(v, [](const dual<T>& d) { return log2(d); });
+		}
+
+		template<typename T, typename Exponent>
+		auto pow(const dual_vector<T>& v, Exponent y) {
+			return transform(v, [y](const dual<T>& d) { return pow(d, y); });
+		}
+
+		/**
+		* 全要素について多項式をHorner法で評価する
+		* @param coeffs 係数の配列、次数の高い順
+		* @param count 係数の数
+		* @param v 入力配列
+		*/
+		template<typename T>
+		dual_vector<T> polyval(const T* coeffs, std::size_t count, const dual_vector<T>& v) {
+			return transform(v, [coeffs, count](const dual<T>& d) { return polyval(coeffs, count, d); });
+		}
+
+		/**
+		* 係数の数がコンパイル時に決まるので、Horner法のループは展開される
+		*/
+		template<typename T, std::size_t N>
+		dual_vector<T> polyval(const std::array<T, N>& coeffs, const dual_vector<T>& v) {
+			return transform(v, [&coeffs](const dual<T>& d) { return polyval(coeffs, d); });
+		}
+
+		template<typename T>
+		dual_vector<T> polyval(std::initializer_list<T> coeffs, const dual_vector<T>& v) {
+			return polyval(coeffs.begin(), coeffs.size(), v);
+		}
+	}
+}
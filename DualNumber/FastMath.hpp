@@ -0,0 +1,221 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "DualNumber.hpp"
+#include "SimdPack.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 高速版の数学関数
+	* @detail libmを呼ばず、値と微分を同じ多項式評価から求める
+	*         分岐を含まない直線的なコードなので、配列に対するループやpackのレーン毎のループはそのままベクトル化される
+	*         その代わりに定義域を絞り、NaN・無限大・非正規化数の扱いは保証しない
+	*         誤差はBenchmarkプロジェクトの精度計測で測ったstd版との差の最大値（double、ULP）
+	*         cmathの関数と名前が同じなので、fast::exp(d) のように修飾して呼ぶこと
+	*         値型はfloat、doubleとそれらのpackに限る（それ以外はstatic_assertで止める）
+	*/
+	namespace fast {
+
+		namespace Detail {
+
+			/**
+			* 高速版の関数が実装されている値型か（floatとdouble、およびそれらのpack）
+			* @detail long doubleなどはdoubleの多項式の精度が足りないので対象外
+			*/
+			template<typename T>
+			constexpr bool is_supported = std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+			template<typename T, std::size_t N>
+			constexpr bool is_supported<pack<T, N>> = is_supported<T>;
+
+			inline std::uint64_t to_bits(double x) {
+				std::uint64_t bits;
+				std::memcpy(&bits, &x, sizeof(bits));
+				return bits;
+			}
+
+			inline double from_bits(std::uint64_t bits) {
+				double x;
+				std::memcpy(&x, &bits, sizeof(x));
+				return x;
+			}
+
+			constexpr double ln2_hi = 6.93147180369123816490e-01;
+			constexpr double ln2_lo = 1.90821492927058770002e-10;
+			constexpr double shift  = 6755399441055744.0;  //1.5 * 2^52、加えて引くと整数に丸められる
+
+			/**
+			* exp(x)
+			* @detail x = n・ln2 + r、|r| <= ln2/2 に縮小し、exp(r)を12次のテイラー多項式で評価して2^nを指数部に直接組み立てる
+			*         xは[-708, 709]であること、範囲外の結果は不定（範囲の丸め込みを入れるとベクトル化されない）
+			*/
+			inline double exp(double x) {
+				//kdの仮数部の下位ビットにnが入る
+				const double kd = x * 1.44269504088896338700e+00 + shift;
+				const double fn = kd - shift;
+				const double r = (x - fn * ln2_hi) - fn * ln2_lo;
+
+				double p = 1.0 / 479001600.0;
+				p = p * r + 1.0 / 39916800.0;
+				p = p * r + 1.0 / 3628800.0;
+				p = p * r + 1.0 / 362880.0;
+				p = p * r + 1.0 / 40320.0;
+				p = p * r + 1.0 / 5040.0;
+				p = p * r + 1.0 / 720.0;
+				p = p * r + 1.0 / 120.0;
+				p = p * r + 1.0 / 24.0;
+				p = p * r + 1.0 / 6.0;
+				p = p * r + 0.5;
+				p = p * r + 1.0;
+				p = p * r + 1.0;
+
+				//(n + 1023)を指数部に置いて2^nを作る、整数と浮動小数点数の変換を避けるとベクトル化しやすい
+				return p * from_bits((to_bits(kd) + 1023) << 52);
+			}
+
+			/**
+			* log(x)
+			* @detail x = 2^k・m、m∈[√2/2, √2)に分解し、fdlibmと同じ s = (m - 1)/(m + 1) の多項式で評価する
+			*         xは正の正規化数であること
+			*/
+			inline double log(double x) {
+				//仮数部が√2より大きければm/2と指数部+1にする、比較と選択は整数で行う（浮動小数点数の条件付き演算があるとベクトル化されない）
+				const std::uint64_t bits = to_bits(x);
+				const std::uint64_t mantissa = bits & 0x000FFFFFFFFFFFFFull;
+				const std::uint64_t large = (0x6A09E667F3BCDull < mantissa) ? 1 : 0;
+				const double m = from_bits(mantissa | ((0x3FFull - large) << 52));
+
+				//指数部を2^52の仮数部に置いて引くことで、整数からの変換をせずにk = e - 1023を得る
+				const double dk = from_bits(((bits >> 52) + large) | 0x4330000000000000ull) - 4503599627371519.0;
+
+				const double f = m - 1.0;
+				const double hfsq = 0.5 * f * f;
+				const double s = f / (2.0 + f);
+				const double z = s * s;
+				const double R = z * (6.666666666666735130e-01 + z * (3.999999999940941908e-01 + z * (2.857142874366239149e-01 + z * (2.222219843214978396e-01 + z * (1.818357216161805012e-01 + z * (1.531383769920937332e-01 + z * 1.479819860511658591e-01))))));
+
+				return dk * ln2_hi - ((hfsq - (s * (hfsq + R) + dk * ln2_lo)) - f);
+			}
+
+			/**
+			* {sin(x), cos(x)}
+			* @detail π/2を3分割したCody-Waite法で[-π/4, π/4]に縮小し、fdlibmの__kernel_sin/__kernel_cosの多項式で評価する
+			*         象限による入れ替えと符号は選択で行う、|x| <= 2^19・π/2 であること
+			*/
+			inline std::pair<double, double> sincos(double x) {
+				const double kd = x * 6.36619772367581382433e-01 + shift;
+				const double fn = kd - shift;
+				const double r = ((x - fn * 1.57079632673412561417e+00) - fn * 6.07710050630396597660e-11) - fn * 2.02226624879595063154e-21;
+				const std::uint64_t n = to_bits(kd);
+
+				const double z = r * r;
+				const double sin_r = r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+				const double cos_r = 1.0 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+
+				//奇数象限ではsinとcosを入れ替え、象限に応じて符号ビットを反転する、いずれも整数のビット演算で行う
+				const std::uint64_t swap = 0 - (n & 1);
+				const std::uint64_t s = to_bits(sin_r);
+				const std::uint64_t c = to_bits(cos_r);
+				const std::uint64_t sin_sign = (n & 2) << 62;
+				const std::uint64_t cos_sign = ((n + 1) & 2) << 62;
+
+				return { from_bits(((c & swap) | (s & ~swap)) ^ sin_sign), from_bits(((s & swap) | (c & ~swap)) ^ cos_sign) };
+			}
+
+			inline float exp(float x) {
+				return static_cast<float>(exp(static_cast<double>(x)));
+			}
+
+			inline float log(float x) {
+				return static_cast<float>(log(static_cast<double>(x)));
+			}
+
+			inline std::pair<float, float> sincos(float x) {
+				const auto sc = sincos(static_cast<double>(x));
+				return { static_cast<float>(sc.first), static_cast<float>(sc.second) };
+			}
+
+			template<typename T, std::size_t N>
+			auto exp(const pack<T, N>& x) {
+				pack<T, N> result{};
+				for (std::size_t i = 0; i < N; ++i) result[i] = exp(x[i]);
+				return result;
+			}
+
+			template<typename T, std::size_t N>
+			auto log(const pack<T, N>& x) {
+				pack<T, N> result{};
+				for (std::size_t i = 0; i < N; ++i) result[i] = log(x[i]);
+				return result;
+			}
+
+			template<typename T, std::size_t N>
+			auto sincos(const pack<T, N>& x) {
+				std::pair<pack<T, N>, pack<T, N>> result{};
+				for (std::size_t i = 0; i < N; ++i) {
+					const auto sc = sincos(x[i]);
+					result.first[i] = sc.first;
+					result.second[i] = sc.second;
+				}
+				return result;
+			}
+		}
+
+		/**
+		* 高速版のexp
+		* @detail 定義域[-708, 709]、値・微分とも最大3ULP
+		*/
+		template<typename T>
+		auto exp(const dual<T>& d) {
+			static_assert(Detail::is_supported<T>, "fast:: functions support only float, double and pack of them; use the cmath overloads for other types");
+			const auto f = Detail::exp(d.a());
+			return dual<T>{f, d.b()*f};
+		}
+
+		/**
+		* 高速版のlog
+		* @detail 定義域は正の正規化数、値は最大1ULP、微分はcmath版と同じ式
+		*/
+		template<typename T>
+		auto log(const dual<T>& d) {
+			static_assert(Detail::is_supported<T>, "fast:: functions support only float, double and pack of them; use the cmath overloads for other types");
+			return dual<T>{Detail::log(d.a()), d.b() / d.a()};
+		}
+
+		/**
+		* 高速版のsincos
+		* @detail 定義域 |x| <= 2^19・π/2、値・微分とも最大1ULP
+		* @return {sin(d), cos(d)}
+		*/
+		template<typename T>
+		auto sincos(const dual<T>& d) {
+			static_assert(Detail::is_supported<T>, "fast:: functions support only float, double and pack of them; use the cmath overloads for other types");
+			const auto sc = Detail::sincos(d.a());
+			return std::pair<dual<T>, dual<T>>{ dual<T>{sc.first, d.b()*sc.second}, dual<T>{sc.second, -d.b()*sc.first} };
+		}
+
+		/**
+		* 高速版のsin
+		* @detail sincosと同じ
+		*/
+		template<typename T>
+		auto sin(const dual<T>& d) {
+			return fast::sincos(d).first;
+		}
+
+		/**
+		* 高速版のcos
+		* @detail sincosと同じ
+		*/
+		template<typename T>
+		auto cos(const dual<T>& d) {
+			return fast::sincos(d).second;
+		}
+	}
+}
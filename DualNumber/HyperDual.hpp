@@ -0,0 +1,577 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+
+#include "DualNumber.hpp"
+#include "MultiDual.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 超双対数（hyper-dual number）、a + bε1 + cε2 + dε1ε2
+	* @detail ε1^2 = ε2^2 = 0、ε1ε2 != 0
+	*         x + ε1 + ε2を入力とすると、1回の評価でε1ε2の係数に厳密な2階微分が得られる
+	* @tparam T 値型、doubleと同じ操作ができる型
+	*/
+	template<typename T>
+	struct hyper_dual {
+		using this_type  = hyper_dual<T>;
+		using value_type = T;
+
+		/**
+		* デフォルトコンストラクタ
+		*/
+		constexpr hyper_dual()
+			: m_a{ 0.0 }
+			, m_b{ 0.0 }
+			, m_c{ 0.0 }
+			, m_d{ 0.0 }
+		{}
+
+		/**
+		* 基本コンストラクタ、値を入れて構築
+		*/
+		constexpr hyper_dual(T a, T b = T(0.0), T c = T(0.0), T d = T(0.0))
+			: m_a{ a }
+			, m_b{ b }
+			, m_c{ c }
+			, m_d{ d }
+		{}
+
+		/**
+		* 2階微分を求めるための変数を構築する
+		* @return x + ε1 + ε2
+		*/
+		static constexpr this_type variable(T x) {
+			return this_type{ x, T(1.0), T(1.0), T(0.0) };
+		}
+
+		constexpr hyper_dual(const this_type& other) = default;
+		constexpr hyper_dual(this_type&& other) = default;
+
+		constexpr this_type& operator=(const this_type& other) & = default;
+		constexpr this_type& operator=(this_type&& other) & = default;
+
+		constexpr operator T() const {
+			return m_a;
+		}
+
+		constexpr this_type operator+() const {
+			return *this;
+		}
+
+		constexpr this_type operator-() const {
+			return this_type{ -m_a, -m_b, -m_c, -m_d };
+		}
+
+		constexpr bool operator==(const this_type& rhs) const {
+			return m_a == rhs.m_a && m_b == rhs.m_b && m_c == rhs.m_c && m_d == rhs.m_d;
+		}
+
+		constexpr this_type& operator++() {
+			++m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator--() {
+			--m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const this_type& rhs) {
+			m_a += rhs.m_a;
+			m_b += rhs.m_b;
+			m_c += rhs.m_c;
+			m_d += rhs.m_d;
+
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const T rhs) {
+			m_a += rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const this_type& rhs) {
+			m_a -= rhs.m_a;
+			m_b -= rhs.m_b;
+			m_c -= rhs.m_c;
+			m_d -= rhs.m_d;
+
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const T rhs) {
+			m_a -= rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const this_type& rhs) {
+			//(a1 + b1ε1 + c1ε2 + d1ε1ε2)(a2 + b2ε1 + c2ε2 + d2ε1ε2)
+			// = a1a2 + (a1b2 + b1a2)ε1 + (a1c2 + c1a2)ε2 + (a1d2 + b1c2 + c1b2 + d1a2)ε1ε2
+			m_d = m_a * rhs.m_d + m_b * rhs.m_c + m_c * rhs.m_b + m_d * rhs.m_a;
+			m_b = m_a * rhs.m_b + m_b * rhs.m_a;
+			m_c = m_a * rhs.m_c + m_c * rhs.m_a;
+			m_a *= rhs.m_a;
+
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const T rhs) {
+			m_a *= rhs;
+			m_b *= rhs;
+			m_c *= rhs;
+			m_d *= rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const this_type& rhs) {
+			return *this *= rhs.inverted();
+		}
+
+		constexpr this_type& operator/=(const T rhs) {
+			m_a /= rhs;
+			m_b /= rhs;
+			m_c /= rhs;
+			m_d /= rhs;
+
+			return *this;
+		}
+
+		/**
+		* 超双対数の逆数を得る
+		* @detail 実部(a)がゼロでないこと
+		* @return 1/x
+		*/
+		constexpr this_type inverted() const {
+			// f(a) = 1/a, f'(a) = -1/a^2, f''(a) = 2/a^3
+			const T inv = T(1.0) / m_a;
+			const T d1 = -inv * inv;
+			return this_type{ inv, d1 * m_b, d1 * m_c, d1 * m_d - T(2.0) * d1 * inv * m_b * m_c };
+		}
+
+		/**
+		* 実部を取得する
+		* @return 実部の値
+		*/
+		constexpr T a() const {
+			return m_a;
+		}
+
+		/**
+		* ε1の係数を取得する
+		* @return ε1の係数
+		*/
+		constexpr T b() const {
+			return m_b;
+		}
+
+		/**
+		* ε2の係数を取得する
+		* @return ε2の係数
+		*/
+		constexpr T c() const {
+			return m_c;
+		}
+
+		/**
+		* ε1ε2の係数を取得する
+		* @return ε1ε2の係数
+		*/
+		constexpr T d() const {
+			return m_d;
+		}
+
+	private:
+		value_type m_a;
+		value_type m_b;
+		value_type m_c;
+		value_type m_d;
+	};
+
+
+	template<typename T>
+	constexpr bool operator!=(const hyper_dual<T>& lhs, const hyper_dual<T>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename T>
+	constexpr auto operator+(const hyper_dual<T>& lhs, const hyper_dual<T>& rhs) {
+		return hyper_dual<T>{lhs} += rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator+(const hyper_dual<T>& lhs, const T rhs) {
+		return hyper_dual<T>{lhs} += rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator+(const T lhs, const hyper_dual<T>& rhs) {
+		return hyper_dual<T>{rhs} += lhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const hyper_dual<T>& lhs, const hyper_dual<T>& rhs) {
+		return hyper_dual<T>{lhs} -= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const hyper_dual<T>& lhs, const T rhs) {
+		return hyper_dual<T>{lhs} -= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator-(const T lhs, const hyper_dual<T>& rhs) {
+		return (-rhs) += lhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const hyper_dual<T>& lhs, const hyper_dual<T>& rhs) {
+		return hyper_dual<T>{lhs} *= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const hyper_dual<T>& lhs, const T rhs) {
+		return hyper_dual<T>{lhs} *= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator*(const T lhs, const hyper_dual<T>& rhs) {
+		return hyper_dual<T>{rhs} *= lhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const hyper_dual<T>& lhs, const hyper_dual<T>& rhs) {
+		return hyper_dual<T>{lhs} /= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const hyper_dual<T>& lhs, const T rhs) {
+		return hyper_dual<T>{lhs} /= rhs;
+	}
+
+	template<typename T>
+	constexpr auto operator/(const T lhs, const hyper_dual<T>& rhs) {
+		return rhs.inverted() *= lhs;
+	}
+
+	template<typename T>
+	std::ostream& operator<<(std::ostream& ostream, const hyper_dual<T>& rhs) {
+		ostream << rhs.a() << " + " << rhs.b() << "e1 + " << rhs.c() << "e2 + " << rhs.d() << "e1e2";
+		return ostream;
+	}
+
+	/**
+	* 2階までの微分を計算する
+	* @brief x + ε1 + ε2でfを1回評価する
+	* @param f hyper_dual<T>を受けて返す関数
+	* @param x 評価点
+	* @return a() == f(x), b() == c() == f'(x), d() == f''(x)
+	*/
+	template<typename T, typename Func>
+	constexpr auto second_derivative(Func&& f, T x) {
+		return f(hyper_dual<T>::variable(x));
+	}
+
+	/**
+	* 方向2階微分を計算する
+	* @brief ε1方向にu、ε2方向にvを与えてfを1回評価する
+	* @param f std::array<hyper_dual<T>, N>を受けてhyper_dual<T>を返す関数
+	* @param x 評価点
+	* @param u 1つめの方向
+	* @param v 2つめの方向
+	* @return d()がu^T H v、b()が∇f・u、c()が∇f・v
+	*/
+	template<typename T, std::size_t N, typename Func>
+	constexpr auto directional_second_derivative(Func&& f, const std::array<T, N>& x, const std::array<T, N>& u, const std::array<T, N>& v) {
+		std::array<hyper_dual<T>, N> vars{};
+		for (std::size_t i = 0; i < N; ++i) {
+			vars[i] = hyper_dual<T>{ x[i], u[i], v[i], T(0.0) };
+		}
+		return f(vars);
+	}
+
+	/**
+	* ヘッセ行列とベクトルの積を計算する
+	* @brief dual<multi_dual<T, N>>（forward-over-forward）でfを1回評価する
+	* @detail 実部の多方向成分で勾配を、虚部でv方向の微分を取るため、虚部の多方向成分がHvになる
+	*         fは引数の型に対して汎用的であること（定数もその型で書く）
+	* @param f std::array<dual<multi_dual<T, N>>, N>を受けて同じ型の値を返す関数
+	* @param x 評価点
+	* @param v ヘッセ行列に掛けるベクトル
+	* @return Hv
+	*/
+	template<typename T, std::size_t N, typename Func>
+	constexpr auto hessian_vector_product(Func&& f, const std::array<T, N>& x, const std::array<T, N>& v) {
+		using inner_type = multi_dual<T, N>;
+
+		std::array<dual<inner_type>, N> vars{};
+		for (std::size_t i = 0; i < N; ++i) {
+			vars[i] = dual<inner_type>{ inner_type::variable(x[i], i), inner_type{ v[i] } };
+		}
+		return f(vars).b().b();
+	}
+
+	inline namespace cmath {
+
+		/**
+		* 連鎖律を適用する
+		* @brief f(a + bε1 + cε2 + dε1ε2) = f(a) + f'(a)bε1 + f'(a)cε2 + (f'(a)d + f''(a)bc)ε1ε2
+		* @param x 関数の入力
+		* @param f0 f(a)
+		* @param f1 f'(a)
+		* @param f2 f''(a)
+		*/
+		template<typename T>
+		constexpr auto chain(const hyper_dual<T>& x, T f0, T f1, T f2) {
+			return hyper_dual<T>{ f0, f1 * x.b(), f1 * x.c(), f1 * x.d() + f2 * x.b() * x.c() };
+		}
+
+		template<typename T>
+		auto atan2(const hyper_dual<T>& y, const hyper_dual<T>& x) {
+			using std::atan2;
+
+			// atan2(y, x) = atan2(ya, xa) + atan2(xa*y - ya*x, xa*x + ya*y)
+			// 第二項の引数の比は実部がゼロなので、atanを通しても値が変わらない
+			auto u = x.a() * y - y.a() * x;
+			auto v = x.a() * x + y.a() * y;
+			return (u / v) += atan2(y.a(), x.a());
+		}
+
+		template<typename T>
+		auto pow(const hyper_dual<T>& f, const hyper_dual<T>& y) {
+			return exp(y * log(f));
+		}
+
+		template<typename Exponent, typename T>
+		auto pow(Exponent f, const hyper_dual<T>& y) {
+			using std::pow;
+			using std::log;
+
+			auto value = pow(f, y.a());
+			auto log_f = log(f);
+			return chain(y, value, value * log_f, value * log_f * log_f);
+		}
+
+		/**
+		* 実数乗
+		* @detail 値はa^pを直接求め、底が正なら f' = p・f/a、f'' = (p-1)・f'/a とする
+		*         底が0以下の場合はa^(p-1)、a^(p-2)も直接求め、係数が0の項は0とする（0の底で 0・∞ = NaN にしない）
+		*/
+		template<typename T, typename Exponent>
+		auto pow(const hyper_dual<T>& d, Exponent y) {
+			using std::pow;
+
+			const T p = static_cast<T>(y);
+			const T value = pow(d.a(), p);
+
+			if (T(0.0) < d.a()) {
+				const T d1 = p * value / d.a();
+				return chain(d, value, d1, (p - T(1.0)) * d1 / d.a());
+			}
+
+			const T c2 = p * (p - T(1.0));
+			const T d1 = (p == T(0.0)) ? T(0.0) : p * pow(d.a(), p - T(1.0));
+			const T d2 = (c2 == T(0.0)) ? T(0.0) : c2 * pow(d.a(), p - T(2.0));
+			return chain(d, value, d1, d2);
+		}
+
+		template<typename T>
+		auto hypot(const hyper_dual<T>& x, const hyper_dual<T>& y) {
+			return sqrt(x * x + y * y);
+		}
+
+		template<typename T>
+		auto sqrt(const hyper_dual<T>& d) {
+			using std::sqrt;
+
+			auto sqrt_a = sqrt(d.a());
+			auto d1 = T(0.5) / sqrt_a;
+			return chain(d, sqrt_a, d1, -T(0.5) * d1 / d.a());
+		}
+
+		template<typename T>
+		auto cbrt(const hyper_dual<T>& d) {
+			using std::cbrt;
+
+			auto cbrt_a = cbrt(d.a());
+			auto d1 = T(1.0) / (T(3.0) * cbrt_a * cbrt_a);
+			return chain(d, cbrt_a, d1, -T(2.0) * d1 / (T(3.0) * d.a()));
+		}
+
+		/**
+		* sinとcosを同時に計算する
+		* @return {sin(d), cos(d)}
+		*/
+		template<typename T>
+		auto sincos(const hyper_dual<T>& d) {
+			const auto sc = Detail::sincos(d.a());
+
+			return std::make_pair(chain(d, sc.first, sc.second, -sc.first), chain(d, sc.second, -sc.first, -sc.second));
+		}
+
+		template<typename T>
+		auto sin(const hyper_dual<T>& d) {
+			const auto sc = Detail::sincos(d.a());
+			return chain(d, sc.first, sc.second, -sc.first);
+		}
+
+		template<typename T>
+		auto cos(const hyper_dual<T>& d) {
+			const auto sc = Detail::sincos(d.a());
+			return chain(d, sc.second, -sc.first, -sc.second);
+		}
+
+		template<typename T>
+		auto tan(const hyper_dual<T>& d) {
+			using std::tan;
+
+			auto tan_a = tan(d.a());
+			auto d1 = T(1.0) + tan_a * tan_a;
+			return chain(d, tan_a, d1, T(2.0) * tan_a * d1);
+		}
+
+		template<typename T>
+		auto asin(const hyper_dual<T>& d) {
+			using std::asin;
+			using std::sqrt;
+
+			auto d1 = T(1.0) / sqrt(T(1.0) - d.a() * d.a());
+			return chain(d, asin(d.a()), d1, d.a() * d1 * d1 * d1);
+		}
+
+		template<typename T>
+		auto acos(const hyper_dual<T>& d) {
+			using std::acos;
+			using std::sqrt;
+
+			auto d1 = T(1.0) / sqrt(T(1.0) - d.a() * d.a());
+			return chain(d, acos(d.a()), -d1, -d.a() * d1 * d1 * d1);
+		}
+
+		template<typename T>
+		auto atan(const hyper_dual<T>& d) {
+			using std::atan;
+
+			auto d1 = T(1.0) / (T(1.0) + d.a() * d.a());
+			return chain(d, atan(d.a()), d1, -T(2.0) * d.a() * d1 * d1);
+		}
+
+		template<typename T>
+		auto sinh(const hyper_dual<T>& d) {
+			using std::sinh;
+			using std::cosh;
+
+			auto sinh_a = sinh(d.a());
+			return chain(d, sinh_a, cosh(d.a()), sinh_a);
+		}
+
+		template<typename T>
+		auto cosh(const hyper_dual<T>& d) {
+			using std::sinh;
+			using std::cosh;
+
+			auto cosh_a = cosh(d.a());
+			return chain(d, cosh_a, sinh(d.a()), cosh_a);
+		}
+
+		template<typename T>
+		auto tanh(const hyper_dual<T>& d) {
+			using std::tanh;
+
+			auto tanh_a = tanh(d.a());
+			auto d1 = T(1.0) - tanh_a * tanh_a;
+			return chain(d, tanh_a, d1, -T(2.0) * tanh_a * d1);
+		}
+
+		template<typename T>
+		auto asinh(const hyper_dual<T>& d) {
+			using std::asinh;
+			using std::sqrt;
+
+			auto d1 = T(1.0) / sqrt(T(1.0) + d.a() * d.a());
+			return chain(d, asinh(d.a()), d1, -d.a() * d1 * d1 * d1);
+		}
+
+		template<typename T>
+		auto acosh(const hyper_dual<T>& d) {
+			using std::acosh;
+			using std::sqrt;
+
+			auto d1 = T(1.0) / sqrt(d.a() * d.a() - T(1.0));
+			return chain(d, acosh(d.a()), d1, -d.a() * d1 * d1 * d1);
+		}
+
+		template<typename T>
+		auto atanh(const hyper_dual<T>& d) {
+			using std::atanh;
+
+			auto d1 = T(1.0) / (T(1.0) - d.a() * d.a());
+			return chain(d, atanh(d.a()), d1, T(2.0) * d.a() * d1 * d1);
+		}
+
+		template<typename T>
+		auto exp(const hyper_dual<T>& d) {
+			using std::exp;
+
+			auto f = exp(d.a());
+			return chain(d, f, f, f);
+		}
+
+		template<typename T>
+		auto exp2(const hyper_dual<T>& d) {
+			using std::exp2;
+
+			auto f = exp2(d.a());
+			auto d1 = f * Constant::loge_2<T>;
+			return chain(d, f, d1, d1 * Constant::loge_2<T>);
+		}
+
+		template<typename T>
+		auto expm1(const hyper_dual<T>& d) {
+			using std::expm1;
+
+			auto f = expm1(d.a());
+			return chain(d, f, f + T(1.0), f + T(1.0));
+		}
+
+		template<typename T>
+		auto log(const hyper_dual<T>& d) {
+			using std::log;
+
+			auto d1 = T(1.0) / d.a();
+			return chain(d, log(d.a()), d1, -d1 * d1);
+		}
+
+		template<typename T>
+		auto log1p(const hyper_dual<T>& d) {
+			using std::log1p;
+
+			auto d1 = T(1.0) / (T(1.0) + d.a());
+			return chain(d, log1p(d.a()), d1, -d1 * d1);
+		}
+
+		template<typename T>
+		auto log10(const hyper_dual<T>& d) {
+			using std::log10;
+
+			auto inv = T(1.0) / d.a();
+			auto d1 = inv / Constant::loge_10<T>;
+			return chain(d, log10(d.a()), d1, -d1 * inv);
+		}
+
+		template<typename T>
+		auto log2(const hyper_dual<T>& d) {
+			using std::log2;
+
+			auto inv = T(1.0) / d.a();
+			auto d1 = inv / Constant::loge_2<T>;
+			return chain(d, log2(d.a()), d1, -d1 * inv);
+		}
+	}
+}
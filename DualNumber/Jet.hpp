@@ -0,0 +1,648 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief K次で打ち切ったテイラー級数（ジェット）
+	* @detail 係数c_k = f^(k)(x)/k!をK+1個保持する
+	*         dual<dual<...>>をK段入れ子にすると成分数が2^Kになるのに対し、こちらはK+1成分で各演算はO(K^2)
+	* @tparam T 値型、doubleと同じ操作ができる型
+	* @tparam K 打ち切り次数
+	*/
+	template<typename T, std::size_t K>
+	struct jet {
+		using this_type  = jet<T, K>;
+		using value_type = T;
+		using coefficients_type = std::array<T, K + 1>;
+
+		static constexpr std::size_t order() {
+			return K;
+		}
+
+		/**
+		* デフォルトコンストラクタ
+		*/
+		constexpr jet()
+			: m_c{}
+		{}
+
+		/**
+		* 定数として構築、1次以上の係数はゼロ
+		*/
+		constexpr jet(T value)
+			: m_c{}
+		{
+			m_c[0] = value;
+		}
+
+		/**
+		* 係数を指定して構築
+		*/
+		constexpr jet(const coefficients_type& coefficients)
+			: m_c{ coefficients }
+		{}
+
+		/**
+		* 独立変数を構築する
+		* @return x + t
+		*/
+		static constexpr this_type variable(T x) {
+			this_type result{ x };
+			if constexpr (0 < K) {
+				result.m_c[1] = T(1.0);
+			}
+			return result;
+		}
+
+		constexpr jet(const this_type& other) = default;
+		constexpr jet(this_type&& other) = default;
+
+		constexpr this_type& operator=(const this_type& other) & = default;
+		constexpr this_type& operator=(this_type&& other) & = default;
+
+		constexpr operator T() const {
+			return m_c[0];
+		}
+
+		constexpr this_type operator+() const {
+			return *this;
+		}
+
+		constexpr this_type operator-() const {
+			this_type result{};
+			for (std::size_t k = 0; k <= K; ++k) result.m_c[k] = -m_c[k];
+			return result;
+		}
+
+		constexpr bool operator==(const this_type& rhs) const {
+			for (std::size_t k = 0; k <= K; ++k) {
+				if (!(m_c[k] == rhs.m_c[k])) return false;
+			}
+			return true;
+		}
+
+		constexpr this_type& operator+=(const this_type& rhs) {
+			for (std::size_t k = 0; k <= K; ++k) m_c[k] += rhs.m_c[k];
+
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const T rhs) {
+			m_c[0] += rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const this_type& rhs) {
+			for (std::size_t k = 0; k <= K; ++k) m_c[k] -= rhs.m_c[k];
+
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const T rhs) {
+			m_c[0] -= rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const this_type& rhs) {
+			// 打ち切り畳み込み、c_k = Σ a_i b_(k-i)
+			coefficients_type result{};
+			for (std::size_t k = 0; k <= K; ++k) {
+				for (std::size_t i = 0; i <= k; ++i) {
+					result[k] += m_c[i] * rhs.m_c[k - i];
+				}
+			}
+			m_c = result;
+
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const T rhs) {
+			for (std::size_t k = 0; k <= K; ++k) m_c[k] *= rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const this_type& rhs) {
+			// c_k = (a_k - Σ_(i=1..k) b_i c_(k-i)) / b_0
+			coefficients_type result{};
+			const T inv = T(1.0) / rhs.m_c[0];
+			result[0] = Detail::quotient(m_c[0], rhs.m_c[0], inv);
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = m_c[k];
+				for (std::size_t i = 1; i <= k; ++i) {
+					sum -= rhs.m_c[i] * result[k - i];
+				}
+				result[k] = sum * inv;
+			}
+			m_c = result;
+
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const T rhs) {
+			for (std::size_t k = 0; k <= K; ++k) m_c[k] /= rhs;
+
+			return *this;
+		}
+
+		/**
+		* テイラー係数を取得する
+		* @param k 次数、K以下であること
+		* @return f^(k)(x)/k!
+		*/
+		constexpr T operator[](std::size_t k) const {
+			return m_c[k];
+		}
+
+		constexpr T& operator[](std::size_t k) {
+			return m_c[k];
+		}
+
+		/**
+		* 微分係数を取得する
+		* @param k 次数、K以下であること
+		* @return f^(k)(x)
+		*/
+		constexpr T derivative(std::size_t k) const {
+			T factorial = T(1.0);
+			for (std::size_t i = 2; i <= k; ++i) factorial *= T(i);
+			return m_c[k] * factorial;
+		}
+
+		/**
+		* 値（0次の係数）を取得する
+		*/
+		constexpr T a() const {
+			return m_c[0];
+		}
+
+		/**
+		* 全係数を取得する
+		*/
+		constexpr const coefficients_type& coefficients() const {
+			return m_c;
+		}
+
+	private:
+		coefficients_type m_c;
+	};
+
+
+	template<typename T, std::size_t K>
+	constexpr bool operator!=(const jet<T, K>& lhs, const jet<T, K>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator+(const jet<T, K>& lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{lhs} += rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator+(const jet<T, K>& lhs, const T rhs) {
+		return jet<T, K>{lhs} += rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator+(const T lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{rhs} += lhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator-(const jet<T, K>& lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{lhs} -= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator-(const jet<T, K>& lhs, const T rhs) {
+		return jet<T, K>{lhs} -= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator-(const T lhs, const jet<T, K>& rhs) {
+		return (-rhs) += lhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator*(const jet<T, K>& lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{lhs} *= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator*(const jet<T, K>& lhs, const T rhs) {
+		return jet<T, K>{lhs} *= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator*(const T lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{rhs} *= lhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator/(const jet<T, K>& lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{lhs} /= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator/(const jet<T, K>& lhs, const T rhs) {
+		return jet<T, K>{lhs} /= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	constexpr auto operator/(const T lhs, const jet<T, K>& rhs) {
+		return jet<T, K>{lhs} /= rhs;
+	}
+
+	template<typename T, std::size_t K>
+	std::ostream& operator<<(std::ostream& ostream, const jet<T, K>& rhs) {
+		ostream << rhs[0];
+		for (std::size_t k = 1; k <= K; ++k) {
+			ostream << " + " << rhs[k] << "t^" << k;
+		}
+		return ostream;
+	}
+
+	/**
+	* テイラー係数を計算する
+	* @brief x + tでfを1回評価する
+	* @param f jet<T, K>を受けて返す関数
+	* @param x 展開点
+	* @return xまわりのK次までのテイラー係数
+	*/
+	template<std::size_t K, typename T, typename Func>
+	constexpr auto taylor_coefficients(Func&& f, T x) {
+		return f(jet<T, K>::variable(x));
+	}
+
+	inline namespace cmath {
+
+		/**
+		* 連鎖律を級数に適用する
+		* @brief y' = g(x)x'を満たすyの係数を求める、y_k = (1/k)Σ_(j=1..k) j x_j g_(k-j)
+		* @param x 関数の入力
+		* @param f0 yの0次の係数
+		* @param g 導関数f'(x)の級数
+		*/
+		template<typename T, std::size_t K>
+		constexpr auto chain(const jet<T, K>& x, T f0, const jet<T, K>& g) {
+			jet<T, K> result{ f0 };
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum += T(j) * x[j] * g[k - j];
+				}
+				result[k] = sum / T(k);
+			}
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto exp(const jet<T, K>& x) {
+			using std::exp;
+
+			// y' = yx'、yの係数は低次から順に決まる
+			jet<T, K> result{ exp(x[0]) };
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum += T(j) * x[j] * result[k - j];
+				}
+				result[k] = sum / T(k);
+			}
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto exp2(const jet<T, K>& x) {
+			using std::exp2;
+
+			auto result = exp(x * Constant::loge_2<T>);
+			result[0] = exp2(x[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto expm1(const jet<T, K>& x) {
+			using std::expm1;
+
+			auto result = exp(x);
+			result[0] = expm1(x[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto log(const jet<T, K>& x) {
+			using std::log;
+
+			// xy' = x'、y_k = (x_k - (1/k)Σ_(j=1..k-1) j y_j x_(k-j)) / x_0
+			jet<T, K> result{ log(x[0]) };
+			const T inv = T(1.0) / x[0];
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = T(0.0);
+				for (std::size_t j = 1; j < k; ++j) {
+					sum += T(j) * result[j] * x[k - j];
+				}
+				result[k] = (x[k] - sum / T(k)) * inv;
+			}
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto log1p(const jet<T, K>& x) {
+			using std::log1p;
+
+			auto result = log(x + T(1.0));
+			result[0] = log1p(x[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto log10(const jet<T, K>& x) {
+			using std::log10;
+
+			auto result = log(x) / Constant::loge_10<T>;
+			result[0] = log10(x[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto log2(const jet<T, K>& x) {
+			using std::log2;
+
+			auto result = log(x) / Constant::loge_2<T>;
+			result[0] = log2(x[0]);
+			return result;
+		}
+
+		/**
+		* 実数乗
+		* @detail 漸化式はx_0で割るので、x_0 = 0では使えない（整数乗は乗算だけで求める下の関数を使う）
+		*/
+		template<typename T, std::size_t K, typename Exponent, std::enable_if_t<!std::is_integral<Exponent>::value, std::nullptr_t> = nullptr>
+		auto pow(const jet<T, K>& x, Exponent y) {
+			using std::pow;
+
+			// xy' = r x' y、y_k = (1/(k x_0))Σ_(j=1..k) ((r+1)j - k) x_j y_(k-j)
+			const T r = static_cast<T>(y);
+			jet<T, K> result{ pow(x[0], r) };
+			const T inv = T(1.0) / x[0];
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum += ((r + T(1.0)) * T(j) - T(k)) * x[j] * result[k - j];
+				}
+				result[k] = sum * inv / T(k);
+			}
+			return result;
+		}
+
+		/**
+		* 整数乗
+		* @detail 二進法でjetの乗算だけで求めるので、x_0 = 0でも係数がNaNにならない
+		*         負の指数は 1/x を|n|乗する
+		*/
+		template<typename T, std::size_t K, typename Integer, std::enable_if_t<std::is_integral<Integer>::value, std::nullptr_t> = nullptr>
+		constexpr auto pow(const jet<T, K>& x, Integer n) {
+			const long long m = static_cast<long long>(n);
+			unsigned long long k = (m < 0) ? 0ull - static_cast<unsigned long long>(m) : static_cast<unsigned long long>(m);
+
+			jet<T, K> base = (m < 0) ? T(1.0) / x : x;
+			jet<T, K> result{ T(1.0) };
+			while (k != 0) {
+				if (k & 1) result *= base;
+				k >>= 1;
+				if (k != 0) base *= base;
+			}
+			return result;
+		}
+
+		template<typename Exponent, typename T, std::size_t K>
+		auto pow(Exponent f, const jet<T, K>& y) {
+			using std::pow;
+			using std::log;
+
+			auto result = exp(y * static_cast<T>(log(f)));
+			result[0] = pow(f, y[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto pow(const jet<T, K>& f, const jet<T, K>& y) {
+			using std::pow;
+
+			auto result = exp(y * log(f));
+			result[0] = pow(f[0], y[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto sqrt(const jet<T, K>& x) {
+			using std::sqrt;
+
+			// y^2 = x、y_k = (x_k - Σ_(j=1..k-1) y_j y_(k-j)) / (2y_0)
+			jet<T, K> result{ sqrt(x[0]) };
+			const T inv = T(0.5) / result[0];
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = x[k];
+				for (std::size_t j = 1; j < k; ++j) {
+					sum -= result[j] * result[k - j];
+				}
+				result[k] = sum * inv;
+			}
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto cbrt(const jet<T, K>& x) {
+			using std::cbrt;
+
+			auto result = pow(x, T(1.0) / T(3.0));
+			result[0] = cbrt(x[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto hypot(const jet<T, K>& x, const jet<T, K>& y) {
+			using std::hypot;
+
+			auto result = sqrt(x * x + y * y);
+			result[0] = hypot(x[0], y[0]);
+			return result;
+		}
+
+		/**
+		* 正弦と余弦を同時に計算する
+		* @brief s' = cx'、c' = -sx'の連立漸化式、sinとcosそれぞれを単独で求めるのと同じコストで両方が得られる
+		* @return {sin(x), cos(x)}
+		*/
+		template<typename T, std::size_t K>
+		auto sincos(const jet<T, K>& x) {
+			const auto sc = Detail::sincos(x[0]);
+
+			jet<T, K> s{ sc.first };
+			jet<T, K> c{ sc.second };
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum_s = T(0.0);
+				T sum_c = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum_s += T(j) * x[j] * c[k - j];
+					sum_c += T(j) * x[j] * s[k - j];
+				}
+				s[k] = sum_s / T(k);
+				c[k] = -sum_c / T(k);
+			}
+			return std::make_pair(s, c);
+		}
+
+		template<typename T, std::size_t K>
+		auto sin(const jet<T, K>& x) {
+			return sincos(x).first;
+		}
+
+		template<typename T, std::size_t K>
+		auto cos(const jet<T, K>& x) {
+			return sincos(x).second;
+		}
+
+		template<typename T, std::size_t K>
+		auto tan(const jet<T, K>& x) {
+			using std::tan;
+
+			// y' = (1 + y^2)x'、u = 1 + y^2の係数をyと同時に求める
+			jet<T, K> result{ tan(x[0]) };
+			jet<T, K> u{ T(1.0) + result[0] * result[0] };
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum += T(j) * x[j] * u[k - j];
+				}
+				result[k] = sum / T(k);
+
+				T sq = T(0.0);
+				for (std::size_t i = 0; i <= k; ++i) {
+					sq += result[i] * result[k - i];
+				}
+				u[k] = sq;
+			}
+			return result;
+		}
+
+		/**
+		* 双曲線正弦と双曲線余弦を同時に計算する
+		* @return {sinh(x), cosh(x)}
+		*/
+		template<typename T, std::size_t K>
+		auto sinhcosh(const jet<T, K>& x) {
+			using std::sinh;
+			using std::cosh;
+
+			jet<T, K> s{ sinh(x[0]) };
+			jet<T, K> c{ cosh(x[0]) };
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum_s = T(0.0);
+				T sum_c = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum_s += T(j) * x[j] * c[k - j];
+					sum_c += T(j) * x[j] * s[k - j];
+				}
+				s[k] = sum_s / T(k);
+				c[k] = sum_c / T(k);
+			}
+			return std::make_pair(s, c);
+		}
+
+		template<typename T, std::size_t K>
+		auto sinh(const jet<T, K>& x) {
+			return sinhcosh(x).first;
+		}
+
+		template<typename T, std::size_t K>
+		auto cosh(const jet<T, K>& x) {
+			return sinhcosh(x).second;
+		}
+
+		template<typename T, std::size_t K>
+		auto tanh(const jet<T, K>& x) {
+			using std::tanh;
+
+			// y' = (1 - y^2)x'
+			jet<T, K> result{ tanh(x[0]) };
+			jet<T, K> u{ T(1.0) - result[0] * result[0] };
+			for (std::size_t k = 1; k <= K; ++k) {
+				T sum = T(0.0);
+				for (std::size_t j = 1; j <= k; ++j) {
+					sum += T(j) * x[j] * u[k - j];
+				}
+				result[k] = sum / T(k);
+
+				T sq = T(0.0);
+				for (std::size_t i = 0; i <= k; ++i) {
+					sq += result[i] * result[k - i];
+				}
+				u[k] = -sq;
+			}
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto asin(const jet<T, K>& x) {
+			using std::asin;
+
+			return chain(x, asin(x[0]), pow(T(1.0) - x * x, T(-0.5)));
+		}
+
+		template<typename T, std::size_t K>
+		auto acos(const jet<T, K>& x) {
+			using std::acos;
+
+			return chain(x, acos(x[0]), -pow(T(1.0) - x * x, T(-0.5)));
+		}
+
+		template<typename T, std::size_t K>
+		auto atan(const jet<T, K>& x) {
+			using std::atan;
+
+			return chain(x, atan(x[0]), T(1.0) / (x * x + T(1.0)));
+		}
+
+		template<typename T, std::size_t K>
+		auto atan2(const jet<T, K>& y, const jet<T, K>& x) {
+			using std::atan2;
+
+			// atan2(y, x) = atan2(y0, x0) + atan((x0*y - y0*x)/(x0*x + y0*y))、atanの引数の0次はゼロ
+			auto result = atan((x[0] * y - y[0] * x) / (x[0] * x + y[0] * y));
+			result[0] = atan2(y[0], x[0]);
+			return result;
+		}
+
+		template<typename T, std::size_t K>
+		auto asinh(const jet<T, K>& x) {
+			using std::asinh;
+
+			return chain(x, asinh(x[0]), pow(x * x + T(1.0), T(-0.5)));
+		}
+
+		template<typename T, std::size_t K>
+		auto acosh(const jet<T, K>& x) {
+			using std::acosh;
+
+			return chain(x, acosh(x[0]), pow(x * x - T(1.0), T(-0.5)));
+		}
+
+		template<typename T, std::size_t K>
+		auto atanh(const jet<T, K>& x) {
+			using std::atanh;
+
+			return chain(x, atanh(x[0]), T(1.0) / (T(1.0) - x * x));
+		}
+	}
+}
@@ -0,0 +1,143 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 等間隔の格子点での関数値と微分の表を作る
+	* @detail f(x + ε)を評価するだけなので、fがconstexprなら表はコンパイル時に作られる
+	*         C++20ではcmathの関数もconstexprになる（DUALNUMBER_HAS_CONSTEXPR_CMATH）
+	* @tparam N 格子点の数
+	* @param lo, hi 区間の両端、両端も格子点に含む
+	* @param f dual<T>を受けてdual<T>を返す関数
+	* @return i番目の要素が {f(x_i), f'(x_i)}、x_i = lo + (hi - lo)・i/(N - 1)
+	*/
+	template<std::size_t N, typename T, typename Func>
+	constexpr std::array<dual<T>, N> make_derivative_table(T lo, T hi, Func&& f) {
+		static_assert(2 <= N, "a table needs at least two grid points");
+
+		std::array<dual<T>, N> table{};
+		for (std::size_t i = 0; i < N; ++i) {
+			table[i] = f(dual<T>{ lo + (hi - lo) * T(i) / T(N - 1), T(1.0) });
+		}
+		return table;
+	}
+
+	/**
+	* @brief 関数値と微分の表による3次エルミート補間
+	* @detail 区間毎に両端の値と微分を通る3次多項式の係数を構築時に求めておき、評価は添字計算とHorner法だけで行う
+	*         補間誤差は格子間隔をhとして h^4/384・max|f''''| 以下
+	*         区間外の点は端の多項式を外挿する
+	* @tparam T 値型
+	* @tparam N 格子点の数
+	*/
+	template<typename T, std::size_t N>
+	class hermite_interpolator {
+	public:
+		using this_type  = hermite_interpolator<T, N>;
+		using value_type = T;
+
+		static_assert(2 <= N, "a table needs at least two grid points");
+
+		/**
+		* @param lo, hi 表の区間
+		* @param table make_derivative_table()で作った表
+		*/
+		constexpr hermite_interpolator(T lo, T hi, const std::array<dual<T>, N>& table)
+			: m_lo{ lo }
+			, m_hi{ hi }
+			, m_step{ (hi - lo) / T(N - 1) }
+			, m_inv_step{ T(N - 1) / (hi - lo) }
+			, m_coefficients{}
+		{
+			//p(u) = c0 + c1・u + c2・u^2 + c3・u^3、u∈[0, 1]、p(0) = y0, p(1) = y1, p'(0) = h・m0, p'(1) = h・m1
+			for (std::size_t i = 0; i < N - 1; ++i) {
+				const T y0 = table[i].a();
+				const T y1 = table[i + 1].a();
+				const T d0 = m_step * table[i].b();
+				const T d1 = m_step * table[i + 1].b();
+				const T dy = y1 - y0;
+
+				m_coefficients[i] = { y0, d0, T(3.0) * dy - d0 - d0 - d1, d0 + d1 - dy - dy };
+			}
+		}
+
+		/**
+		* 補間値
+		*/
+		constexpr T operator()(T x) const {
+			T u{};
+			const auto& c = interval(x, u);
+			return ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+		}
+
+		/**
+		* 補間値とその微分
+		* @detail 微分は補間多項式の微分で、表の微分と格子点で一致する
+		*/
+		constexpr dual<T> operator()(const dual<T>& x) const {
+			T u{};
+			const auto& c = interval(x.a(), u);
+			const T value = ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+			const T slope = ((T(3.0) * c[3] * u + T(2.0) * c[2]) * u + c[1]) * m_inv_step;
+			return dual<T>{ value, x.b() * slope };
+		}
+
+		constexpr T lo() const {
+			return m_lo;
+		}
+
+		constexpr T hi() const {
+			return m_hi;
+		}
+
+		/**
+		* 格子点の数
+		*/
+		static constexpr std::size_t size() {
+			return N;
+		}
+
+	private:
+
+		/**
+		* xを含む区間の係数と、区間内の位置u∈[0, 1]
+		*/
+		constexpr const std::array<T, 4>& interval(T x, T& u) const {
+			const T t = (x - m_lo) * m_inv_step;
+
+			std::size_t i = 0;
+			if (!(T(0.0) < t)) {
+				i = 0;
+			} else if (T(N - 2) <= t) {
+				i = N - 2;
+			} else {
+				i = static_cast<std::size_t>(t);
+			}
+
+			u = t - T(i);
+			return m_coefficients[i];
+		}
+
+		T m_lo;
+		T m_hi;
+		T m_step;
+		T m_inv_step;
+		std::array<std::array<T, 4>, N - 1> m_coefficients;
+	};
+
+	/**
+	* @brief 表を作ってそのまま補間器にする
+	* @tparam N 格子点の数
+	* @param lo, hi 区間の両端
+	* @param f dual<T>を受けてdual<T>を返す関数
+	*/
+	template<std::size_t N, typename T, typename Func>
+	constexpr hermite_interpolator<T, N> make_hermite_interpolator(T lo, T hi, Func&& f) {
+		return hermite_interpolator<T, N>{ lo, hi, make_derivative_table<N>(lo, hi, f) };
+	}
+}
@@ -0,0 +1,465 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 多方向の双対数、虚部がN次元のベクトル
+	* @detail 1回の評価でN方向の微分（勾配）を同時に計算する、虚部は連続領域に保持されるため接ベクトルのループはベクトル化できる
+	* @tparam T 値型、doubleと同じ操作ができる型
+	* @tparam N 虚部の次元（方向の数）
+	*/
+	template<typename T, std::size_t N>
+	struct multi_dual {
+		using this_type    = multi_dual<T, N>;
+		using value_type   = T;
+		using tangent_type = std::array<T, N>;
+
+		static constexpr std::size_t size() {
+			return N;
+		}
+
+		/**
+		* デフォルトコンストラクタ
+		*/
+		constexpr multi_dual()
+			: m_a{ 0.0 }
+			, m_b{}
+		{}
+
+		/**
+		* 定数として構築、虚部は全てゼロ
+		*/
+		constexpr multi_dual(T a)
+			: m_a{ a }
+			, m_b{}
+		{}
+
+		/**
+		* 基本コンストラクタ、値を入れて構築
+		*/
+		constexpr multi_dual(T a, const tangent_type& b)
+			: m_a{ a }
+			, m_b{ b }
+		{}
+
+		/**
+		* 独立変数を構築する
+		* @brief index番目の方向の虚部だけが1の値を作る
+		* @param a 実部
+		* @param index 変数の番号、N未満であること
+		* @return a + e_index ε
+		*/
+		static constexpr this_type variable(T a, std::size_t index) {
+			this_type result{ a };
+			result.m_b[index] = T(1.0);
+			return result;
+		}
+
+		constexpr multi_dual(const this_type& other) = default;
+		constexpr multi_dual(this_type&& other) = default;
+
+		constexpr this_type& operator=(const this_type& other) & = default;
+		constexpr this_type& operator=(this_type&& other) & = default;
+
+		constexpr operator T() const {
+			return m_a;
+		}
+
+		constexpr this_type operator+() const {
+			return *this;
+		}
+
+		constexpr this_type operator-() const {
+			this_type result{ -m_a };
+			for (std::size_t i = 0; i < N; ++i) result.m_b[i] = -m_b[i];
+			return result;
+		}
+
+		constexpr bool operator==(const this_type& rhs) const {
+			if (!(m_a == rhs.m_a)) return false;
+			for (std::size_t i = 0; i < N; ++i) {
+				if (!(m_b[i] == rhs.m_b[i])) return false;
+			}
+			return true;
+		}
+
+		constexpr this_type& operator++() {
+			++m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator--() {
+			--m_a;
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const this_type& rhs) {
+			m_a += rhs.m_a;
+			for (std::size_t i = 0; i < N; ++i) m_b[i] += rhs.m_b[i];
+
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const T rhs) {
+			m_a += rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const this_type& rhs) {
+			m_a -= rhs.m_a;
+			for (std::size_t i = 0; i < N; ++i) m_b[i] -= rhs.m_b[i];
+
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const T rhs) {
+			m_a -= rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const this_type& rhs) {
+			//(a+bε)*(c+dε) = ac + (ad + bc)ε
+			for (std::size_t i = 0; i < N; ++i) m_b[i] = m_b[i] * rhs.m_a + m_a * rhs.m_b[i];
+			m_a *= rhs.m_a;
+
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const T rhs) {
+			for (std::size_t i = 0; i < N; ++i) m_b[i] *= rhs;
+			m_a *= rhs;
+
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const this_type& rhs) {
+			// (a+bε)/(c+dε) = a/c + (b - (a/c)d)ε/c
+			const T inv = T(1.0) / rhs.m_a;
+			m_a = Detail::quotient(m_a, rhs.m_a, inv);
+			for (std::size_t i = 0; i < N; ++i) m_b[i] = (m_b[i] - m_a * rhs.m_b[i]) * inv;
+
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const T rhs) {
+			m_a /= rhs;
+			for (std::size_t i = 0; i < N; ++i) m_b[i] /= rhs;
+
+			return *this;
+		}
+
+		/**
+		* 実部を取得する
+		* @return 実部の値
+		*/
+		constexpr T a() const {
+			return m_a;
+		}
+
+		/**
+		* 虚部を取得する
+		* @return N方向の虚部
+		*/
+		constexpr const tangent_type& b() const {
+			return m_b;
+		}
+
+		/**
+		* 虚部の1成分を取得する
+		* @param index 方向の番号
+		* @return index番目の方向の虚部
+		*/
+		constexpr T b(std::size_t index) const {
+			return m_b[index];
+		}
+
+	private:
+		value_type m_a;
+		tangent_type m_b;
+	};
+
+
+	template<typename T, std::size_t N>
+	constexpr bool operator!=(const multi_dual<T, N>& lhs, const multi_dual<T, N>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator+(const multi_dual<T, N>& lhs, const multi_dual<T, N>& rhs) {
+		return multi_dual<T, N>{lhs} += rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator+(const multi_dual<T, N>& lhs, const T rhs) {
+		return multi_dual<T, N>{lhs} += rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator+(const T lhs, const multi_dual<T, N>& rhs) {
+		return multi_dual<T, N>{rhs} += lhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator-(const multi_dual<T, N>& lhs, const multi_dual<T, N>& rhs) {
+		return multi_dual<T, N>{lhs} -= rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator-(const multi_dual<T, N>& lhs, const T rhs) {
+		return multi_dual<T, N>{lhs} -= rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator-(const T lhs, const multi_dual<T, N>& rhs) {
+		return (-rhs) += lhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator*(const multi_dual<T, N>& lhs, const multi_dual<T, N>& rhs) {
+		return multi_dual<T, N>{lhs} *= rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator*(const multi_dual<T, N>& lhs, const T rhs) {
+		return multi_dual<T, N>{lhs} *= rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator*(const T lhs, const multi_dual<T, N>& rhs) {
+		return multi_dual<T, N>{rhs} *= lhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator/(const multi_dual<T, N>& lhs, const multi_dual<T, N>& rhs) {
+		return multi_dual<T, N>{lhs} /= rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator/(const multi_dual<T, N>& lhs, const T rhs) {
+		return multi_dual<T, N>{lhs} /= rhs;
+	}
+
+	template<typename T, std::size_t N>
+	constexpr auto operator/(const T lhs, const multi_dual<T, N>& rhs) {
+		// l/(c+dε) = l/c - (l/c)dε/c
+		const T inv = T(1.0) / rhs.a();
+		const T real = Detail::quotient(lhs, rhs.a(), inv);
+		multi_dual<T, N> result{ rhs };
+		result *= -real * inv;
+		return multi_dual<T, N>{ real, result.b() };
+	}
+
+	template<typename T, std::size_t N>
+	std::ostream& operator<<(std::ostream& ostream, const multi_dual<T, N>& rhs) {
+		ostream << rhs.a() << " + (";
+		for (std::size_t i = 0; i < N; ++i) {
+			ostream << (i == 0 ? "" : ", ") << rhs.b(i);
+		}
+		ostream << ")e";
+		return ostream;
+	}
+
+	/**
+	* 勾配を計算する
+	* @brief xの各成分を独立変数としてfを1回評価し、値と勾配を得る
+	* @param f multi_dual<T, N>を受けて返す関数
+	* @param x 評価点
+	* @return f(x) + ∇f(x)ε
+	*/
+	template<typename T, std::size_t N, typename Func>
+	constexpr auto gradient(Func&& f, const std::array<T, N>& x) {
+		std::array<multi_dual<T, N>, N> vars{};
+		for (std::size_t i = 0; i < N; ++i) {
+			vars[i] = multi_dual<T, N>::variable(x[i], i);
+		}
+		return f(vars);
+	}
+
+	inline namespace cmath {
+
+		/**
+		* 連鎖律を適用する
+		* @brief 実部に対する関数値とその微分から、N方向全ての虚部を更新する
+		* @param x 関数の入力
+		* @param df 実部での関数値と微分、(f(a), f'(a))
+		* @return f(a) + f'(a)bε
+		*/
+		template<typename T, std::size_t N>
+		constexpr auto chain(const multi_dual<T, N>& x, const dual<T>& df) {
+			multi_dual<T, N> result{ x };
+			result *= df.b();
+			return multi_dual<T, N>{ df.a(), result.b() };
+		}
+
+		/**
+		* 2変数関数の連鎖律を適用する
+		* @param value 関数値
+		* @param dx xに関する偏微分
+		* @param x 第一引数
+		* @param dy yに関する偏微分
+		* @param y 第二引数
+		* @return value + (dx*bx + dy*by)ε
+		* @detail 値型が算術型の場合、虚部が0の方向は偏微分を掛けない（負の底のpowの∂/∂yのようなNaNや∞を、その引数に依存しない方向へ伝えない）
+		*/
+		template<typename T, std::size_t N>
+		constexpr auto chain(T value, T dx, const multi_dual<T, N>& x, T dy, const multi_dual<T, N>& y) {
+			std::array<T, N> b{};
+			for (std::size_t i = 0; i < N; ++i) {
+				if constexpr (std::is_arithmetic<T>::value) {
+					const T bx = (x.b(i) == T(0.0)) ? T(0.0) : dx * x.b(i);
+					const T by = (y.b(i) == T(0.0)) ? T(0.0) : dy * y.b(i);
+					b[i] = bx + by;
+				} else {
+					b[i] = dx * x.b(i) + dy * y.b(i);
+				}
+			}
+			return multi_dual<T, N>{ value, b };
+		}
+
+		/**
+		* 偏微分 {値, 第一引数, 第二引数} から2変数関数の連鎖律を適用する
+		*/
+		template<typename T, std::size_t N>
+		constexpr auto chain(const std::array<T, 3>& partials, const multi_dual<T, N>& x, const multi_dual<T, N>& y) {
+			return chain(partials[0], partials[1], x, partials[2], y);
+		}
+
+		template<typename T, std::size_t N>
+		auto atan2(const multi_dual<T, N>& y, const multi_dual<T, N>& x) {
+			return chain(Detail::atan2_partials(y.a(), x.a()), y, x);
+		}
+
+		template<typename T, std::size_t N>
+		auto pow(const multi_dual<T, N>& f, const multi_dual<T, N>& y) {
+			return chain(Detail::pow_partials(f.a(), y.a()), f, y);
+		}
+
+		template<typename Exponent, typename T, std::size_t N>
+		auto pow(Exponent f, const multi_dual<T, N>& y) {
+			return chain(y, pow(f, dual<T>{ y.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N, typename Exponent>
+		auto pow(const multi_dual<T, N>& d, Exponent y) {
+			return chain(d, pow(dual<T>{ d.a(), T(1.0) }, y));
+		}
+
+		template<typename T, std::size_t N>
+		auto hypot(const multi_dual<T, N>& x, const multi_dual<T, N>& y) {
+			return chain(Detail::hypot_partials(x.a(), y.a()), x, y);
+		}
+
+		template<typename T, std::size_t N>
+		auto sqrt(const multi_dual<T, N>& d) {
+			return chain(d, sqrt(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto cbrt(const multi_dual<T, N>& d) {
+			return chain(d, cbrt(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto sin(const multi_dual<T, N>& d) {
+			return chain(d, sin(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto cos(const multi_dual<T, N>& d) {
+			return chain(d, cos(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto tan(const multi_dual<T, N>& d) {
+			return chain(d, tan(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto asin(const multi_dual<T, N>& d) {
+			return chain(d, asin(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto acos(const multi_dual<T, N>& d) {
+			return chain(d, acos(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto atan(const multi_dual<T, N>& d) {
+			return chain(d, atan(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto sinh(const multi_dual<T, N>& d) {
+			return chain(d, sinh(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto cosh(const multi_dual<T, N>& d) {
+			return chain(d, cosh(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto tanh(const multi_dual<T, N>& d) {
+			return chain(d, tanh(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto asinh(const multi_dual<T, N>& d) {
+			return chain(d, asinh(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto acosh(const multi_dual<T, N>& d) {
+			return chain(d, acosh(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto atanh(const multi_dual<T, N>& d) {
+			return chain(d, atanh(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto exp(const multi_dual<T, N>& d) {
+			return chain(d, exp(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto exp2(const multi_dual<T, N>& d) {
+			return chain(d, exp2(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto expm1(const multi_dual<T, N>& d) {
+			return chain(d, expm1(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto log(const multi_dual<T, N>& d) {
+			return chain(d, log(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto log1p(const multi_dual<T, N>& d) {
+			return chain(d, log1p(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto log10(const multi_dual<T, N>& d) {
+			return chain(d, log10(dual<T>{ d.a(), T(1.0) }));
+		}
+
+		template<typename T, std::size_t N>
+		auto log2(const multi_dual<T, N>& d) {
+			return chain(d, log2(dual<T>{ d.a(), T(1.0) }));
+		}
+	}
+}
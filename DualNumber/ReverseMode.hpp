@@ -0,0 +1,580 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <iostream>
+
+#include "DualNumber.hpp"
+#include "MultiDual.hpp"
+
+namespace DualNumbers {
+
+	template<typename T>
+	class var;
+
+	/**
+	* @brief テープに記録される演算の種類
+	* @detail 記録したテープを別の入力で再評価（リプレイ）するために使う
+	*         *_constantはテープに記録されない定数を右辺に、constant_*は左辺に取る
+	*         pow_integerは整数の指数を右辺に取る
+	*/
+	enum class opcode : unsigned char {
+		variable,
+		add, subtract, multiply, divide, negate,
+		add_constant, subtract_constant, constant_subtract,
+		multiply_constant, divide_constant, constant_divide,
+		pow_constant, constant_pow, pow_integer,
+		atan2, pow, hypot,
+		sqrt, cbrt,
+		sin, cos, tan, asin, acos, atan,
+		sinh, cosh, tanh, asinh, acosh, atanh,
+		exp, exp2, expm1, log, log1p, log10, log2
+	};
+
+	/**
+	* 2変数の演算か
+	* @param op 演算の種類
+	* @return 第二の親に偏微分係数を持つならtrue
+	*/
+	constexpr bool is_binary(opcode op) {
+		switch (op) {
+		case opcode::add: case opcode::subtract: case opcode::multiply: case opcode::divide:
+		case opcode::atan2: case opcode::pow: case opcode::hypot:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	* @brief リバースモード自動微分のテープ
+	* @detail 演算の記録（節点）を固定長ブロックのアリーナに積む、ノード毎のヒープ確保は行わない
+	*         clear()後もブロックは保持され、次の記録で再利用される
+	* @tparam T 値型
+	*/
+	template<typename T>
+	class tape {
+	public:
+		using index_type = std::size_t;
+
+		/**
+		* 1ブロックに格納する節点の数
+		*/
+		static constexpr std::size_t block_size = 4096;
+
+		/**
+		* @brief 記録された1演算、2つの親とそれぞれへの偏微分係数
+		* @detail 1変数の演算は第二の親を第一の親と同じにして偏微分係数をゼロにする
+		*         constantは定数との演算ではその定数、独立変数では記録時の値
+		*         exponentはpow_integerの指数
+		*/
+		struct node {
+			index_type lhs;
+			index_type rhs;
+			T d_lhs;
+			T d_rhs;
+			T constant;
+			long long exponent;
+			opcode op;
+		};
+
+		tape() = default;
+
+		tape(const tape&) = delete;
+		tape& operator=(const tape&) = delete;
+
+		/**
+		* 独立変数を記録する
+		* @param value 変数の値
+		* @return テープ上の変数
+		*/
+		var<T> variable(T value) {
+			const index_type index = m_size;
+			push(opcode::variable, index, T(0.0), index, T(0.0), value);
+			return var<T>{ this, index, value };
+		}
+
+		/**
+		* 1変数の演算を記録する
+		* @param op 演算の種類
+		* @param parent 入力の節点
+		* @param d_parent 入力に関する偏微分係数
+		* @param constant 演算に使われた定数
+		* @param exponent 演算に使われた整数の指数
+		* @return 記録した節点の番号
+		*/
+		index_type push(opcode op, index_type parent, T d_parent, T constant = T(0.0), long long exponent = 0) {
+			return push(op, parent, d_parent, parent, T(0.0), constant, exponent);
+		}
+
+		/**
+		* 2変数の演算を記録する
+		* @param op 演算の種類
+		* @param lhs 第一の入力の節点
+		* @param d_lhs 第一の入力に関する偏微分係数
+		* @param rhs 第二の入力の節点
+		* @param d_rhs 第二の入力に関する偏微分係数
+		* @param constant 演算に使われた定数
+		* @param exponent 演算に使われた整数の指数
+		* @return 記録した節点の番号
+		*/
+		index_type push(opcode op, index_type lhs, T d_lhs, index_type rhs, T d_rhs, T constant = T(0.0), long long exponent = 0) {
+			const index_type index = m_size;
+			const std::size_t block = index / block_size;
+
+			if (block == m_blocks.size()) {
+				m_blocks.emplace_back(new node[block_size]);
+			}
+
+			m_blocks[block][index % block_size] = node{ lhs, rhs, d_lhs, d_rhs, constant, exponent, op };
+			++m_size;
+
+			return index;
+		}
+
+		/**
+		* 逆方向に1回走査して随伴値を計算する
+		* @brief 全ての節点についてresultの偏微分を求める
+		* @detail 随伴値がゼロの節点と、独立変数と1変数の演算の第二の親は足し込まない
+		*         ゼロと無限大の積がNaNになって無関係な節点や偏微分係数がゼロの親に伝播するため
+		* @param result 微分される値
+		*/
+		void backward(const var<T>& result) {
+			m_adjoints.assign(m_size, T(0.0));
+			m_adjoints[result.index()] = T(1.0);
+
+			for (index_type i = m_size; i-- > 0;) {
+				const node& n = m_blocks[i / block_size][i % block_size];
+				const T adjoint = m_adjoints[i];
+
+				if (n.op == opcode::variable || adjoint == T(0.0)) continue;
+
+				m_adjoints[n.lhs] += n.d_lhs * adjoint;
+				if (is_binary(n.op)) m_adjoints[n.rhs] += n.d_rhs * adjoint;
+			}
+		}
+
+		/**
+		* 随伴値を得る
+		* @detail backward()の後であること
+		* @param v テープ上の変数
+		* @return vに関する偏微分係数
+		*/
+		T adjoint(const var<T>& v) const {
+			return m_adjoints[v.index()];
+		}
+
+		/**
+		* 記録を消去する
+		* @detail 確保済みのブロックは解放せず再利用する
+		*/
+		void clear() noexcept {
+			m_size = 0;
+			m_adjoints.clear();
+		}
+
+		/**
+		* 記録された節点の数
+		*/
+		std::size_t size() const noexcept {
+			return m_size;
+		}
+
+		/**
+		* 節点を取得する
+		* @param index 節点の番号
+		*/
+		const node& operator[](index_type index) const {
+			return m_blocks[index / block_size][index % block_size];
+		}
+
+	private:
+		std::vector<std::unique_ptr<node[]>> m_blocks;
+		std::vector<T> m_adjoints;
+		std::size_t m_size = 0;
+	};
+
+	/**
+	* @brief リバースモード自動微分の変数
+	* @detail 値と、テープ上の節点の番号を持つ、演算は値を計算しつつ偏微分係数をテープに記録する
+	* @tparam T 値型
+	*/
+	template<typename T>
+	class var {
+	public:
+		using this_type  = var<T>;
+		using value_type = T;
+		using index_type = typename tape<T>::index_type;
+
+		constexpr var(tape<T>* t, index_type index, T value)
+			: m_tape{ t }
+			, m_index{ index }
+			, m_value{ value }
+		{}
+
+		/**
+		* 値を取得する
+		*/
+		constexpr T value() const {
+			return m_value;
+		}
+
+		/**
+		* テープ上の節点の番号を取得する
+		*/
+		constexpr index_type index() const {
+			return m_index;
+		}
+
+		/**
+		* 記録先のテープを取得する
+		*/
+		constexpr tape<T>* get_tape() const {
+			return m_tape;
+		}
+
+		/**
+		* 1変数の演算の結果を記録する
+		* @param op 演算の種類
+		* @param value 演算結果の値
+		* @param d この変数に関する偏微分係数
+		* @param constant 演算に使われた定数
+		* @param exponent 演算に使われた整数の指数
+		*/
+		this_type unary(opcode op, T value, T d, T constant = T(0.0), long long exponent = 0) const {
+			return this_type{ m_tape, m_tape->push(op, m_index, d, constant, exponent), value };
+		}
+
+		/**
+		* 2変数の演算の結果を記録する
+		* @param op 演算の種類
+		* @param value 演算結果の値
+		* @param d_this この変数に関する偏微分係数
+		* @param other もう一方の変数
+		* @param d_other otherに関する偏微分係数
+		*/
+		this_type binary(opcode op, T value, T d_this, const this_type& other, T d_other) const {
+			return this_type{ m_tape, m_tape->push(op, m_index, d_this, other.m_index, d_other), value };
+		}
+
+		this_type operator+() const {
+			return *this;
+		}
+
+		this_type operator-() const {
+			return unary(opcode::negate, -m_value, T(-1.0));
+		}
+
+		this_type& operator+=(const this_type& rhs) {
+			return *this = *this + rhs;
+		}
+
+		this_type& operator+=(const T rhs) {
+			return *this = *this + rhs;
+		}
+
+		this_type& operator-=(const this_type& rhs) {
+			return *this = *this - rhs;
+		}
+
+		this_type& operator-=(const T rhs) {
+			return *this = *this - rhs;
+		}
+
+		this_type& operator*=(const this_type& rhs) {
+			return *this = *this * rhs;
+		}
+
+		this_type& operator*=(const T rhs) {
+			return *this = *this * rhs;
+		}
+
+		this_type& operator/=(const this_type& rhs) {
+			return *this = *this / rhs;
+		}
+
+		this_type& operator/=(const T rhs) {
+			return *this = *this / rhs;
+		}
+
+	private:
+		tape<T>* m_tape;
+		index_type m_index;
+		value_type m_value;
+	};
+
+
+	template<typename T>
+	bool operator==(const var<T>& lhs, const var<T>& rhs) {
+		return lhs.value() == rhs.value();
+	}
+
+	template<typename T>
+	bool operator!=(const var<T>& lhs, const var<T>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename T>
+	bool operator<(const var<T>& lhs, const var<T>& rhs) {
+		return lhs.value() < rhs.value();
+	}
+
+	template<typename T>
+	bool operator<=(const var<T>& lhs, const var<T>& rhs) {
+		return !(rhs < lhs);
+	}
+
+	template<typename T>
+	bool operator>(const var<T>& lhs, const var<T>& rhs) {
+		return rhs < lhs;
+	}
+
+	template<typename T>
+	bool operator>=(const var<T>& lhs, const var<T>& rhs) {
+		return !(lhs < rhs);
+	}
+
+	template<typename T>
+	auto operator+(const var<T>& lhs, const var<T>& rhs) {
+		return lhs.binary(opcode::add, lhs.value() + rhs.value(), T(1.0), rhs, T(1.0));
+	}
+
+	template<typename T>
+	auto operator+(const var<T>& lhs, const T rhs) {
+		return lhs.unary(opcode::add_constant, lhs.value() + rhs, T(1.0), rhs);
+	}
+
+	template<typename T>
+	auto operator+(const T lhs, const var<T>& rhs) {
+		return rhs.unary(opcode::add_constant, lhs + rhs.value(), T(1.0), lhs);
+	}
+
+	template<typename T>
+	auto operator-(const var<T>& lhs, const var<T>& rhs) {
+		return lhs.binary(opcode::subtract, lhs.value() - rhs.value(), T(1.0), rhs, T(-1.0));
+	}
+
+	template<typename T>
+	auto operator-(const var<T>& lhs, const T rhs) {
+		return lhs.unary(opcode::subtract_constant, lhs.value() - rhs, T(1.0), rhs);
+	}
+
+	template<typename T>
+	auto operator-(const T lhs, const var<T>& rhs) {
+		return rhs.unary(opcode::constant_subtract, lhs - rhs.value(), T(-1.0), lhs);
+	}
+
+	template<typename T>
+	auto operator*(const var<T>& lhs, const var<T>& rhs) {
+		return lhs.binary(opcode::multiply, lhs.value() * rhs.value(), rhs.value(), rhs, lhs.value());
+	}
+
+	template<typename T>
+	auto operator*(const var<T>& lhs, const T rhs) {
+		return lhs.unary(opcode::multiply_constant, lhs.value() * rhs, rhs, rhs);
+	}
+
+	template<typename T>
+	auto operator*(const T lhs, const var<T>& rhs) {
+		return rhs.unary(opcode::multiply_constant, lhs * rhs.value(), lhs, lhs);
+	}
+
+	template<typename T>
+	auto operator/(const var<T>& lhs, const var<T>& rhs) {
+		const T inv = T(1.0) / rhs.value();
+		const T value = Detail::quotient(lhs.value(), rhs.value(), inv);
+		return lhs.binary(opcode::divide, value, inv, rhs, -value * inv);
+	}
+
+	template<typename T>
+	auto operator/(const var<T>& lhs, const T rhs) {
+		return lhs.unary(opcode::divide_constant, lhs.value() / rhs, T(1.0) / rhs, rhs);
+	}
+
+	template<typename T>
+	auto operator/(const T lhs, const var<T>& rhs) {
+		const T inv = T(1.0) / rhs.value();
+		const T value = Detail::quotient(lhs, rhs.value(), inv);
+		return rhs.unary(opcode::constant_divide, value, -value * inv, lhs);
+	}
+
+	template<typename T>
+	std::ostream& operator<<(std::ostream& ostream, const var<T>& rhs) {
+		ostream << rhs.value();
+		return ostream;
+	}
+
+	inline namespace cmath {
+
+		/**
+		* 1変数関数を記録する
+		* @brief 偏微分係数は双対数版の関数で計算する（フォワードモードと同じ微分規則を使う）
+		* @param op 演算の種類
+		* @param x 入力
+		* @param f dual<T>を受けて返す関数
+		* @param constant 関数に使われた定数
+		* @param exponent 関数に使われた整数の指数
+		*/
+		template<typename T, typename Func>
+		auto record(opcode op, const var<T>& x, Func&& f, T constant = T(0.0), long long exponent = 0) {
+			const dual<T> d = f(dual<T>{ x.value(), T(1.0) });
+			return x.unary(op, d.a(), d.b(), constant, exponent);
+		}
+
+		/**
+		* 2変数関数を記録する
+		* @brief 2つの偏微分係数はmulti_dual<T, 2>版の関数で1回の評価で計算する
+		* @param op 演算の種類
+		* @param x 第一引数
+		* @param y 第二引数
+		* @param f multi_dual<T, 2>を2つ受けて返す関数
+		*/
+		template<typename T, typename Func>
+		auto record(opcode op, const var<T>& x, const var<T>& y, Func&& f) {
+			using seed_type = multi_dual<T, 2>;
+
+			const seed_type d = f(seed_type::variable(x.value(), 0), seed_type::variable(y.value(), 1));
+			return x.binary(op, d.a(), d.b(0), y, d.b(1));
+		}
+
+		template<typename T>
+		auto atan2(const var<T>& y, const var<T>& x) {
+			return record(opcode::atan2, y, x, [](const auto& y, const auto& x) { return atan2(y, x); });
+		}
+
+		template<typename T>
+		auto pow(const var<T>& f, const var<T>& y) {
+			return record(opcode::pow, f, y, [](const auto& f, const auto& y) { return pow(f, y); });
+		}
+
+		template<typename Exponent, typename T>
+		auto pow(Exponent f, const var<T>& y) {
+			return record(opcode::constant_pow, y, [f](const dual<T>& y) { return pow(f, y); }, T(f));
+		}
+
+		template<typename T, typename Exponent, std::enable_if_t<!std::is_integral<Exponent>::value, std::nullptr_t> = nullptr>
+		auto pow(const var<T>& d, Exponent y) {
+			return record(opcode::pow_constant, d, [y](const dual<T>& d) { return pow(d, y); }, T(y));
+		}
+
+		/**
+		* @brief 整数の指数は整数版のpowで微分し、リプレイでも同じ関数を使えるように指数を整数のまま記録する
+		*/
+		template<typename T, typename Integer, std::enable_if_t<std::is_integral<Integer>::value, std::nullptr_t> = nullptr>
+		auto pow(const var<T>& d, Integer n) {
+			const long long m = static_cast<long long>(n);
+			return record(opcode::pow_integer, d, [m](const dual<T>& d) { return pow(d, m); }, T(m), m);
+		}
+
+		template<typename T>
+		auto hypot(const var<T>& x, const var<T>& y) {
+			return record(opcode::hypot, x, y, [](const auto& x, const auto& y) { return hypot(x, y); });
+		}
+
+		template<typename T>
+		auto sqrt(const var<T>& x) {
+			return record(opcode::sqrt, x, [](const dual<T>& d) { return sqrt(d); });
+		}
+
+		template<typename T>
+		auto cbrt(const var<T>& x) {
+			return record(opcode::cbrt, x, [](const dual<T>& d) { return cbrt(d); });
+		}
+
+		template<typename T>
+		auto sin(const var<T>& x) {
+			return record(opcode::sin, x, [](const dual<T>& d) { return sin(d); });
+		}
+
+		template<typename T>
+		auto cos(const var<T>& x) {
+			return record(opcode::cos, x, [](const dual<T>& d) { return cos(d); });
+		}
+
+		template<typename T>
+		auto tan(const var<T>& x) {
+			return record(opcode::tan, x, [](const dual<T>& d) { return tan(d); });
+		}
+
+		template<typename T>
+		auto asin(const var<T>& x) {
+			return record(opcode::asin, x, [](const dual<T>& d) { return asin(d); });
+		}
+
+		template<typename T>
+		auto acos(const var<T>& x) {
+			return record(opcode::acos, x, [](const dual<T>& d) { return acos(d); });
+		}
+
+		template<typename T>
+		auto atan(const var<T>& x) {
+			return record(opcode::atan, x, [](const dual<T>& d) { return atan(d); });
+		}
+
+		template<typename T>
+		auto sinh(const var<T>& x) {
+			return record(opcode::sinh, x, [](const dual<T>& d) { return sinh(d); });
+		}
+
+		template<typename T>
+		auto cosh(const var<T>& x) {
+			return record(opcode::cosh, x, [](const dual<T>& d) { return cosh(d); });
+		}
+
+		template<typename T>
+		auto tanh(const var<T>& x) {
+			return record(opcode::tanh, x, [](const dual<T>& d) { return tanh(d); });
+		}
+
+		template<typename T>
+		auto asinh(const var<T>& x) {
+			return record(opcode::asinh, x, [](const dual<T>& d) { return asinh(d); });
+		}
+
+		template<typename T>
+		auto acosh(const var<T>& x) {
+			return record(opcode::acosh, x, [](const dual<T>& d) { return acosh(d); });
+		}
+
+		template<typename T>
+		auto atanh(const var<T>& x) {
+			return record(opcode::atanh, x, [](const dual<T>& d) { return atanh(d); });
+		}
+
+		template<typename T>
+		auto exp(const var<T>& x) {
+			return record(opcode::exp, x, [](const dual<T>& d) { return exp(d); });
+		}
+
+		template<typename T>
+		auto exp2(const var<T>& x) {
+			return record(opcode::exp2, x, [](const dual<T>& d) { return exp2(d); });
+		}
+
+		template<typename T>
+		auto expm1(const var<T>& x) {
+			return record(opcode::expm1, x, [](const dual<T>& d) { return expm1(d); });
+		}
+
+		template<typename T>
+		auto log(const var<T>& x) {
+			return record(opcode::log, x, [](const dual<T>& d) { return log(d); });
+		}
+
+		template<typename T>
+		auto log1p(const var<T>& x) {
+			return record(opcode::log1p, x, [](const dual<T>& d) { return log1p(d); });
+		}
+
+		template<typename T>
+		auto log10(const var<T>& x) {
+			return record(opcode::log10, x, [](const dual<T>& d) { return log10(d); });
+		}
+
+		template<typename T>
+		auto log2(const var<T>& x) {
+			return record(opcode::log2, x, [](const dual<T>& d) { return log2(d); });
+		}
+	}
+}
@@ -0,0 +1,482 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <iostream>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief packの要素毎の比較結果
+	* @tparam N レーン数
+	*/
+	template<std::size_t N>
+	struct pack_mask {
+		using this_type = pack_mask<N>;
+
+		static constexpr std::size_t size() {
+			return N;
+		}
+
+		constexpr pack_mask()
+			: m_v{}
+		{}
+
+		/**
+		* 全レーンを同じ値で構築する
+		*/
+		constexpr pack_mask(bool value)
+			: m_v{}
+		{
+			for (std::size_t i = 0; i < N; ++i) m_v[i] = value;
+		}
+
+		constexpr bool operator[](std::size_t lane) const {
+			return m_v[lane];
+		}
+
+		constexpr bool& operator[](std::size_t lane) {
+			return m_v[lane];
+		}
+
+		constexpr this_type operator!() const {
+			this_type result{};
+			for (std::size_t i = 0; i < N; ++i) result.m_v[i] = !m_v[i];
+			return result;
+		}
+
+		friend constexpr this_type operator&&(const this_type& lhs, const this_type& rhs) {
+			this_type result{};
+			for (std::size_t i = 0; i < N; ++i) result.m_v[i] = lhs.m_v[i] && rhs.m_v[i];
+			return result;
+		}
+
+		friend constexpr this_type operator||(const this_type& lhs, const this_type& rhs) {
+			this_type result{};
+			for (std::size_t i = 0; i < N; ++i) result.m_v[i] = lhs.m_v[i] || rhs.m_v[i];
+			return result;
+		}
+
+	private:
+		bool m_v[N];
+	};
+
+	/**
+	* 全レーンが真か
+	*/
+	template<std::size_t N>
+	constexpr bool all_of(const pack_mask<N>& mask) {
+		for (std::size_t i = 0; i < N; ++i) {
+			if (!mask[i]) return false;
+		}
+		return true;
+	}
+
+	/**
+	* いずれかのレーンが真か
+	*/
+	template<std::size_t N>
+	constexpr bool any_of(const pack_mask<N>& mask) {
+		for (std::size_t i = 0; i < N; ++i) {
+			if (mask[i]) return true;
+		}
+		return false;
+	}
+
+	/**
+	* 全レーンが偽か
+	*/
+	template<std::size_t N>
+	constexpr bool none_of(const pack_mask<N>& mask) {
+		return !any_of(mask);
+	}
+
+	/**
+	* 真のレーン数
+	*/
+	template<std::size_t N>
+	constexpr std::size_t popcount(const pack_mask<N>& mask) {
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < N; ++i) {
+			count += mask[i] ? 1 : 0;
+		}
+		return count;
+	}
+
+	/**
+	* packのアライメント、sizeof(T)・N以上の最小の2の冪
+	* @detail alignasには2の冪しか指定できないので、レーン数が2の冪でない場合は切り上げる
+	*/
+	template<typename T, std::size_t N>
+	constexpr std::size_t pack_alignment() {
+		std::size_t alignment = alignof(T);
+		while (alignment < sizeof(T) * N) alignment *= 2;
+		return alignment;
+	}
+
+	/**
+	* @brief SIMDレーン型、doubleと同じ操作をN個の値に対して要素毎に行う
+	* @detail 演算は固定長のループで書かれており、コンパイラのベクトル化でパックド命令になる
+	*         dual<pack<T, N>>とすることで1回の双対数演算でN個の微分を計算できる
+	* @tparam T 要素の型
+	* @tparam N レーン数
+	*/
+	template<typename T, std::size_t N>
+	struct alignas(pack_alignment<T, N>()) pack {
+		using this_type  = pack<T, N>;
+		using value_type = T;
+		using mask_type  = pack_mask<N>;
+
+		static constexpr std::size_t size() {
+			return N;
+		}
+
+		constexpr pack()
+			: m_v{}
+		{}
+
+		/**
+		* 全レーンを同じ値で構築する（ブロードキャスト）
+		*/
+		constexpr pack(T value)
+			: m_v{}
+		{
+			for (std::size_t i = 0; i < N; ++i) m_v[i] = value;
+		}
+
+		/**
+		* 連続したN個の値を読み込む
+		* @param ptr N個の値を指すポインタ
+		*/
+		static constexpr this_type load(const T* ptr) {
+			this_type result{};
+			for (std::size_t i = 0; i < N; ++i) result.m_v[i] = ptr[i];
+			return result;
+		}
+
+		/**
+		* 連続したN個の領域に書き出す
+		* @param ptr N個の値を書き込めるポインタ
+		*/
+		constexpr void store(T* ptr) const {
+			for (std::size_t i = 0; i < N; ++i) ptr[i] = m_v[i];
+		}
+
+		constexpr T operator[](std::size_t lane) const {
+			return m_v[lane];
+		}
+
+		constexpr T& operator[](std::size_t lane) {
+			return m_v[lane];
+		}
+
+		constexpr this_type operator+() const {
+			return *this;
+		}
+
+		constexpr this_type operator-() const {
+			this_type result{};
+			for (std::size_t i = 0; i < N; ++i) result.m_v[i] = -m_v[i];
+			return result;
+		}
+
+		constexpr this_type& operator++() {
+			for (std::size_t i = 0; i < N; ++i) ++m_v[i];
+			return *this;
+		}
+
+		constexpr this_type& operator--() {
+			for (std::size_t i = 0; i < N; ++i) --m_v[i];
+			return *this;
+		}
+
+		constexpr this_type& operator+=(const this_type& rhs) {
+			for (std::size_t i = 0; i < N; ++i) m_v[i] += rhs.m_v[i];
+			return *this;
+		}
+
+		constexpr this_type& operator-=(const this_type& rhs) {
+			for (std::size_t i = 0; i < N; ++i) m_v[i] -= rhs.m_v[i];
+			return *this;
+		}
+
+		constexpr this_type& operator*=(const this_type& rhs) {
+			for (std::size_t i = 0; i < N; ++i) m_v[i] *= rhs.m_v[i];
+			return *this;
+		}
+
+		constexpr this_type& operator/=(const this_type& rhs) {
+			for (std::size_t i = 0; i < N; ++i) m_v[i] /= rhs.m_v[i];
+			return *this;
+		}
+
+		friend constexpr this_type operator+(const this_type& lhs, const this_type& rhs) {
+			return this_type{ lhs } += rhs;
+		}
+
+		friend constexpr this_type operator-(const this_type& lhs, const this_type& rhs) {
+			return this_type{ lhs } -= rhs;
+		}
+
+		friend constexpr this_type operator*(const this_type& lhs, const this_type& rhs) {
+			return this_type{ lhs } *= rhs;
+		}
+
+		friend constexpr this_type operator/(const this_type& lhs, const this_type& rhs) {
+			return this_type{ lhs } /= rhs;
+		}
+
+		friend constexpr mask_type operator==(const this_type& lhs, const this_type& rhs) {
+			mask_type result{};
+			for (std::size_t i = 0; i < N; ++i) result[i] = lhs.m_v[i] == rhs.m_v[i];
+			return result;
+		}
+
+		friend constexpr mask_type operator!=(const this_type& lhs, const this_type& rhs) {
+			return !(lhs == rhs);
+		}
+
+		friend constexpr mask_type operator<(const this_type& lhs, const this_type& rhs) {
+			mask_type result{};
+			for (std::size_t i = 0; i < N; ++i) result[i] = lhs.m_v[i] < rhs.m_v[i];
+			return result;
+		}
+
+		friend constexpr mask_type operator>(const this_type& lhs, const this_type& rhs) {
+			return rhs < lhs;
+		}
+
+		friend constexpr mask_type operator<=(const this_type& lhs, const this_type& rhs) {
+			return !(rhs < lhs);
+		}
+
+		friend constexpr mask_type operator>=(const this_type& lhs, const this_type& rhs) {
+			return !(lhs < rhs);
+		}
+
+	private:
+		T m_v[N];
+	};
+
+	template<typename T, std::size_t N>
+	std::ostream& operator<<(std::ostream& ostream, const pack<T, N>& rhs) {
+		ostream << "(";
+		for (std::size_t i = 0; i < N; ++i) {
+			ostream << (i == 0 ? "" : ", ") << rhs[i];
+		}
+		ostream << ")";
+		return ostream;
+	}
+
+	/**
+	* マスクされた選択
+	* @brief maskが真のレーンはtrue_value、偽のレーンはfalse_valueを取る
+	* @param mask 選択マスク
+	* @param true_value 真のレーンの値
+	* @param false_value 偽のレーンの値
+	*/
+	template<typename T, std::size_t N>
+	constexpr auto where(const pack_mask<N>& mask, const pack<T, N>& true_value, const pack<T, N>& false_value) {
+		pack<T, N> result{};
+		for (std::size_t i = 0; i < N; ++i) {
+			result[i] = mask[i] ? true_value[i] : false_value[i];
+		}
+		return result;
+	}
+
+	/**
+	* 双対数のマスクされた選択
+	* @brief 実部・虚部ともにmaskが真のレーンはtrue_value、偽のレーンはfalse_valueを取る
+	*/
+	template<typename T, std::size_t N>
+	constexpr auto where(const pack_mask<N>& mask, const dual<pack<T, N>>& true_value, const dual<pack<T, N>>& false_value) {
+		return dual<pack<T, N>>{ where(mask, true_value.a(), false_value.a()), where(mask, true_value.b(), false_value.b()) };
+	}
+
+	/**
+	* 双対数のレーンを取り出す
+	* @param d SIMDレーンを持つ双対数
+	* @param lane レーン番号
+	* @return laneの位置のスカラー双対数
+	*/
+	template<typename T, std::size_t N>
+	constexpr auto extract(const dual<pack<T, N>>& d, std::size_t lane) {
+		return dual<T>{ d.a()[lane], d.b()[lane] };
+	}
+
+	using pack_f4 = pack<float, 4>;
+	using pack_f8 = pack<float, 8>;
+	using pack_d2 = pack<double, 2>;
+	using pack_d4 = pack<double, 4>;
+	using pack_d8 = pack<double, 8>;
+
+	inline namespace cmath {
+
+		/**
+		* 要素毎に関数を適用する
+		* @param x 入力
+		* @param f スカラー関数
+		*/
+		template<typename T, std::size_t N, typename Func>
+		auto apply(const pack<T, N>& x, Func&& f) {
+			pack<T, N> result{};
+			for (std::size_t i = 0; i < N; ++i) result[i] = f(x[i]);
+			return result;
+		}
+
+		/**
+		* 要素毎に2引数関数を適用する
+		* @param x 第一引数
+		* @param y 第二引数
+		* @param f スカラー関数
+		*/
+		template<typename T, std::size_t N, typename Func>
+		auto apply(const pack<T, N>& x, const pack<T, N>& y, Func&& f) {
+			pack<T, N> result{};
+			for (std::size_t i = 0; i < N; ++i) result[i] = f(x[i], y[i]);
+			return result;
+		}
+
+		template<typename T, std::size_t N>
+		auto abs(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::abs(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto fabs(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::fabs(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto sqrt(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::sqrt(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto cbrt(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::cbrt(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto sin(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::sin(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto cos(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::cos(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto tan(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::tan(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto asin(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::asin(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto acos(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::acos(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto atan(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::atan(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto sinh(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::sinh(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto cosh(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::cosh(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto tanh(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::tanh(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto asinh(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::asinh(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto acosh(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::acosh(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto atanh(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::atanh(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto exp(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::exp(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto exp2(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::exp2(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto expm1(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::expm1(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto log(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::log(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto log1p(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::log1p(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto log10(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::log10(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto log2(const pack<T, N>& x) {
+			return apply(x, [](T v) { return std::log2(v); });
+		}
+
+		template<typename T, std::size_t N>
+		auto pow(const pack<T, N>& x, const pack<T, N>& y) {
+			return apply(x, y, [](T v, T w) { return std::pow(v, w); });
+		}
+
+		template<typename T, std::size_t N>
+		auto pow(const pack<T, N>& x, T y) {
+			return apply(x, [y](T v) { return std::pow(v, y); });
+		}
+
+		template<typename T, std::size_t N>
+		auto pow(T x, const pack<T, N>& y) {
+			return apply(y, [x](T w) { return std::pow(x, w); });
+		}
+
+		template<typename T, std::size_t N>
+		auto atan2(const pack<T, N>& y, const pack<T, N>& x) {
+			return apply(y, x, [](T v, T w) { return std::atan2(v, w); });
+		}
+
+		template<typename T, std::size_t N>
+		auto hypot(const pack<T, N>& x, const pack<T, N>& y) {
+			return apply(x, y, [](T v, T w) { return std::hypot(v, w); });
+		}
+	}
+}
@@ -0,0 +1,280 @@
+﻿#pragma once
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "DualNumber.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief (次数, 引数)をキーに特殊関数の値を保持する、容量固定のスレッドセーフなキャッシュ
+	* @detail オープンアドレス法で、ハッシュ位置から probe_length 個の連続したスロットを探す
+	*         空きがなければその範囲でCLOCK法（参照ビットによるセカンドチャンス）で追い出す
+	*         値の計算はロックの外で行うので、ミスした計算同士は並行に進む
+	* @tparam T 次数と引数の型
+	* @tparam V 値の型
+	*/
+	template<typename T, typename V = T>
+	class special_function_cache {
+	public:
+
+		/**
+		* 1つのキーについて探すスロットの数
+		*/
+		static constexpr std::size_t probe_length = 8;
+
+		/**
+		* @param capacity 保持するエントリ数の上限、2のべき乗に切り上げられる
+		*/
+		explicit special_function_cache(std::size_t capacity = 4096)
+			: m_entries(round_up(capacity))
+			, m_mask(m_entries.size() - 1)
+		{}
+
+		special_function_cache(const special_function_cache&) = delete;
+		special_function_cache& operator=(const special_function_cache&) = delete;
+
+		/**
+		* キャッシュされた値を返す、なければ計算して登録する
+		* @param nu 次数
+		* @param x 引数
+		* @param f (nu, x)を受けて値を返す関数
+		*/
+		template<typename Func>
+		V get(T nu, T x, Func&& f) {
+			const std::size_t home = hash(nu, x) & m_mask;
+
+			{
+				std::lock_guard<std::mutex> lock{ m_mutex };
+
+				if (entry* e = find(home, nu, x)) {
+					e->referenced = true;
+					m_hits.fetch_add(1, std::memory_order_relaxed);
+					return e->value;
+				}
+			}
+
+			m_misses.fetch_add(1, std::memory_order_relaxed);
+			const V value = f(nu, x);
+
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			entry& victim = m_entries[select_victim(home, nu, x)];
+			victim = entry{ nu, x, value, true, false };
+
+			return value;
+		}
+
+		/**
+		* 全エントリを捨てる、カウンタはそのまま
+		*/
+		void clear() {
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			for (auto& e : m_entries) e = entry{};
+		}
+
+		/**
+		* ヒット数とミス数をゼロに戻す
+		*/
+		void reset_statistics() noexcept {
+			m_hits.store(0, std::memory_order_relaxed);
+			m_misses.store(0, std::memory_order_relaxed);
+		}
+
+		std::size_t hits() const noexcept {
+			return m_hits.load(std::memory_order_relaxed);
+		}
+
+		std::size_t misses() const noexcept {
+			return m_misses.load(std::memory_order_relaxed);
+		}
+
+		std::size_t capacity() const noexcept {
+			return m_entries.size();
+		}
+
+	private:
+
+		struct entry {
+			T nu{};
+			T x{};
+			V value{};
+			bool occupied = false;
+			bool referenced = false;
+		};
+
+		static std::size_t round_up(std::size_t capacity) {
+			std::size_t size = probe_length;
+			while (size < capacity) size <<= 1;
+			return size;
+		}
+
+		static std::size_t hash(T nu, T x) {
+			const std::size_t h = std::hash<T>{}(nu);
+			return (h ^ (std::hash<T>{}(x) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2))) * 0x9E3779B97F4A7C15ull >> 16;
+		}
+
+		/**
+		* 探索範囲からキーが一致するエントリを探す、ロックを取ってから呼ぶ
+		* @return 見つからなければnullptr
+		*/
+		entry* find(std::size_t home, T nu, T x) {
+			for (std::size_t i = 0; i < probe_length; ++i) {
+				entry& e = m_entries[(home + i) & m_mask];
+				if (e.occupied && e.nu == nu && e.x == x) return &e;
+			}
+			return nullptr;
+		}
+
+		/**
+		* 登録先のスロットを選ぶ、ロックを取ってから呼ぶ
+		* @detail 値の計算中に他のスレッドが同じキーを登録していればそのスロットを上書きし、重複して登録しない
+		*         なければ探索範囲の空きを、空きもなければ参照ビットを落としながら回り、落ちていたスロットを返す
+		*/
+		std::size_t select_victim(std::size_t home, T nu, T x) {
+			if (const entry* e = find(home, nu, x)) return static_cast<std::size_t>(e - m_entries.data());
+
+			for (std::size_t i = 0; i < probe_length; ++i) {
+				const std::size_t slot = (home + i) & m_mask;
+				if (!m_entries[slot].occupied) return slot;
+			}
+
+			while (true) {
+				const std::size_t slot = (home + m_hand) & m_mask;
+				m_hand = (m_hand + 1) % probe_length;
+
+				entry& e = m_entries[slot];
+				if (!e.referenced) return slot;
+				e.referenced = false;
+			}
+		}
+
+		std::vector<entry> m_entries;
+		std::size_t m_mask;
+		std::size_t m_hand = 0;
+
+		std::mutex m_mutex;
+		std::atomic<std::size_t> m_hits{ 0 };
+		std::atomic<std::size_t> m_misses{ 0 };
+	};
+
+#if 201603L <= __cpp_lib_math_special_functions
+
+	/**
+	* @brief キャッシュを通して各種ベッセル関数を計算する
+	* @detail 中心の次数と、微分に使う隣の次数の呼び出しがそれぞれキャッシュを通る
+	*         ハンケル関数はJとYのキャッシュを共有する
+	* @tparam T 値型
+	*/
+	template<typename T>
+	class bessel_cache {
+	public:
+
+		/**
+		* @param capacity 関数毎のエントリ数の上限
+		*/
+		explicit bessel_cache(std::size_t capacity = 4096)
+			: m_j{ capacity }
+			, m_y{ capacity }
+			, m_i{ capacity }
+			, m_k{ capacity }
+		{}
+
+		/**
+		* 第一種ベッセル関数
+		*/
+		dual<T> cyl_bessel_j(T nu, const dual<T>& x) {
+			return calculateBesselFunctions(nu, x, [this](T nu, T x) { return j(nu, x); });
+		}
+
+		/**
+		* 第二種ベッセル関数(ノイマン関数)
+		*/
+		dual<T> cyl_neumann(T nu, const dual<T>& x) {
+			return calculateBesselFunctions(nu, x, [this](T nu, T x) { return y(nu, x); });
+		}
+
+		/**
+		* 第三種ベッセル関数(ハンケル関数の一つ、虚部の符号がプラス)
+		*/
+		dual<std::complex<T>> cyl_hankel_1(T nu, const dual<T>& x) {
+			return calculateBesselFunctions(nu, x, [this](T nu, T x) { return std::complex<T>{ j(nu, x), y(nu, x) }; });
+		}
+
+		/**
+		* 第三種ベッセル関数(ハンケル関数の一つ、虚部の符号がマイナス)
+		*/
+		dual<std::complex<T>> cyl_hankel_2(T nu, const dual<T>& x) {
+			return calculateBesselFunctions(nu, x, [this](T nu, T x) { return std::complex<T>{ j(nu, x), -y(nu, x) }; });
+		}
+
+		/**
+		* 第一種変形ベッセル関数
+		*/
+		dual<T> cyl_bessel_i(T nu, const dual<T>& x) {
+			return calculateModifiedBesselFunctions(nu, x, [this](T nu, T x) { return m_i.get(nu, x, [](T nu, T x) { using std::cyl_bessel_i; return cyl_bessel_i(nu, x); }); });
+		}
+
+		/**
+		* 第二種変形ベッセル関数
+		*/
+		dual<T> cyl_bessel_k(T nu, const dual<T>& x) {
+			dual<T> d = calculateModifiedBesselFunctions(nu, x, [this](T nu, T x) { return m_k.get(nu, x, [](T nu, T x) { using std::cyl_bessel_k; return cyl_bessel_k(nu, x); }); });
+			return dual<T>{d.a(), -d.b()};
+		}
+
+		/**
+		* 全ての関数のヒット数の合計
+		*/
+		std::size_t hits() const noexcept {
+			return m_j.hits() + m_y.hits() + m_i.hits() + m_k.hits();
+		}
+
+		/**
+		* 全ての関数のミス数の合計
+		*/
+		std::size_t misses() const noexcept {
+			return m_j.misses() + m_y.misses() + m_i.misses() + m_k.misses();
+		}
+
+		void clear() {
+			m_j.clear();
+			m_y.clear();
+			m_i.clear();
+			m_k.clear();
+		}
+
+		void reset_statistics() noexcept {
+			m_j.reset_statistics();
+			m_y.reset_statistics();
+			m_i.reset_statistics();
+			m_k.reset_statistics();
+		}
+
+		const special_function_cache<T>& cache_j() const noexcept { return m_j; }
+		const special_function_cache<T>& cache_y() const noexcept { return m_y; }
+		const special_function_cache<T>& cache_i() const noexcept { return m_i; }
+		const special_function_cache<T>& cache_k() const noexcept { return m_k; }
+
+	private:
+
+		T j(T nu, T x) {
+			return m_j.get(nu, x, [](T nu, T x) { using std::cyl_bessel_j; return cyl_bessel_j(nu, x); });
+		}
+
+		T y(T nu, T x) {
+			return m_y.get(nu, x, [](T nu, T x) { using std::cyl_neumann; return cyl_neumann(nu, x); });
+		}
+
+		special_function_cache<T> m_j;
+		special_function_cache<T> m_y;
+		special_function_cache<T> m_i;
+		special_function_cache<T> m_k;
+	};
+
+#endif // __cpp_lib_math_special_functions
+}
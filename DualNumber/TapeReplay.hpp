@@ -0,0 +1,391 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ReverseMode.hpp"
+#include "SimdPack.hpp"
+
+namespace DualNumbers {
+
+	/**
+	* @brief 記録済みのテープを入力のバッチに対して再評価する
+	* @detail 参照評価で一度だけ記録したテープから出力に寄与する演算だけを抜き出して命令列にし、
+	*         SoA配置の入力をWレーンのpack単位で評価する
+	*         演算の振り分けは命令毎に1回だけ行われ、レーン方向のループには分岐も演算子オーバーロードの間接化も残らない
+	*         偏微分係数の計算はvar<T>と同じくdual/multi_dualのcmathを使う
+	* @tparam T 値型
+	* @tparam W 1命令で処理する点の数
+	*/
+	template<typename T, std::size_t W = 32 / sizeof(T)>
+	class replay {
+	public:
+		using value_type = T;
+		using lane_type  = pack<T, W>;
+		using index_type = typename tape<T>::index_type;
+
+		/**
+		* テープから命令列を作る
+		* @param source 記録済みのテープ
+		* @param output 出力となる変数
+		* @detail テープ上の独立変数が記録された順に入力となる
+		*/
+		replay(const tape<T>& source, const var<T>& output) {
+			const index_type last = output.index();
+			std::vector<bool> live(last + 1, false);
+
+			live[last] = true;
+			for (index_type i = last + 1; i-- > 0;) {
+				const auto& n = source[i];
+
+				if (n.op == opcode::variable) {
+					live[i] = true;
+				} else if (live[i]) {
+					live[n.lhs] = true;
+					live[n.rhs] = true;
+				}
+			}
+
+			std::vector<index_type> renumber(last + 1, 0);
+
+			for (index_type i = 0; i <= last; ++i) {
+				if (!live[i]) continue;
+
+				const auto& n = source[i];
+				const index_type index = m_code.size();
+				renumber[i] = index;
+
+				if (n.op == opcode::variable) {
+					m_inputs.push_back(index);
+					m_code.push_back(instruction{ index, index, n.constant, n.exponent, n.op });
+				} else {
+					m_code.push_back(instruction{ renumber[n.lhs], renumber[n.rhs], n.constant, n.exponent, n.op });
+				}
+			}
+
+			m_output = renumber[last];
+			m_values.resize(m_code.size());
+			m_d_lhs.assign(m_code.size(), lane_type{});
+			m_d_rhs.assign(m_code.size(), lane_type{});
+			m_adjoints.resize(m_code.size());
+		}
+
+		/**
+		* 命令の数
+		*/
+		std::size_t size() const noexcept {
+			return m_code.size();
+		}
+
+		/**
+		* 入力の数
+		*/
+		std::size_t inputs() const noexcept {
+			return m_inputs.size();
+		}
+
+		/**
+		* 出力の値だけを計算する
+		* @param inputs 入力毎のcount個の値を指すポインタの配列
+		* @param count 点の数
+		* @param output count個の出力を書き込む領域
+		*/
+		void evaluate(const T* const* inputs, std::size_t count, T* output) {
+			for (std::size_t base = 0; base < count; base += W) {
+				const std::size_t n = (count - base < W) ? count - base : W;
+
+				load(inputs, base, n);
+				forward<false>();
+				store(m_values[m_output], output + base, n);
+			}
+		}
+
+		/**
+		* 出力の値と全ての入力に関する偏微分を計算する
+		* @param inputs 入力毎のcount個の値を指すポインタの配列
+		* @param count 点の数
+		* @param output count個の出力を書き込む領域
+		* @param gradients 入力毎のcount個の偏微分を書き込む領域を指すポインタの配列
+		*/
+		void gradient(const T* const* inputs, std::size_t count, T* output, T* const* gradients) {
+			for (std::size_t base = 0; base < count; base += W) {
+				const std::size_t n = (count - base < W) ? count - base : W;
+
+				load(inputs, base, n);
+				forward<true>();
+				backward();
+
+				store(m_values[m_output], output + base, n);
+				for (std::size_t k = 0; k < m_inputs.size(); ++k) {
+					store(m_adjoints[m_inputs[k]], gradients[k] + base, n);
+				}
+			}
+		}
+
+	private:
+
+		/**
+		* @brief 1命令、1変数の演算ではrhsはlhsと同じ
+		*/
+		struct instruction {
+			index_type lhs;
+			index_type rhs;
+			T constant;
+			long long exponent;
+			opcode op;
+		};
+
+		/**
+		* 端数の点は最後の点の値で埋めて読み込む
+		*/
+		void load(const T* const* inputs, std::size_t base, std::size_t n) {
+			for (std::size_t k = 0; k < m_inputs.size(); ++k) {
+				const T* ptr = inputs[k] + base;
+
+				if (n == W) {
+					m_values[m_inputs[k]] = lane_type::load(ptr);
+				} else {
+					lane_type lane{ ptr[n - 1] };
+					for (std::size_t i = 0; i < n; ++i) lane[i] = ptr[i];
+					m_values[m_inputs[k]] = lane;
+				}
+			}
+		}
+
+		static void store(const lane_type& lane, T* ptr, std::size_t n) {
+			if (n == W) {
+				lane.store(ptr);
+			} else {
+				for (std::size_t i = 0; i < n; ++i) ptr[i] = lane[i];
+			}
+		}
+
+		template<bool Gradient, typename Func>
+		void unary(std::size_t i, Func&& f) {
+			const lane_type& x = m_values[m_code[i].lhs];
+
+			if constexpr (Gradient) {
+				const dual<lane_type> d = f(dual<lane_type>{ x, lane_type{ T(1.0) } });
+				m_values[i] = d.a();
+				m_d_lhs[i] = d.b();
+			} else {
+				m_values[i] = f(x);
+			}
+		}
+
+		template<bool Gradient, typename Func>
+		void binary(std::size_t i, Func&& f) {
+			using seed_type = multi_dual<lane_type, 2>;
+
+			const lane_type& x = m_values[m_code[i].lhs];
+			const lane_type& y = m_values[m_code[i].rhs];
+
+			if constexpr (Gradient) {
+				const seed_type d = f(seed_type::variable(x, 0), seed_type::variable(y, 1));
+				m_values[i] = d.a();
+				m_d_lhs[i] = d.b(0);
+				m_d_rhs[i] = d.b(1);
+			} else {
+				m_values[i] = f(x, y);
+			}
+		}
+
+		/**
+		* 全命令を順に評価する
+		* @tparam Gradient 偏微分係数も計算するか
+		*/
+		template<bool Gradient>
+		void forward() {
+			for (std::size_t i = 0; i < m_code.size(); ++i) {
+				const instruction& in = m_code[i];
+				const lane_type& x = m_values[in.lhs];
+				const lane_type& y = m_values[in.rhs];
+				const lane_type c{ in.constant };
+
+				switch (in.op) {
+				case opcode::variable:
+					break;
+				case opcode::add:
+					m_values[i] = x + y;
+					if constexpr (Gradient) {
+						m_d_lhs[i] = lane_type{ T(1.0) };
+						m_d_rhs[i] = lane_type{ T(1.0) };
+					}
+					break;
+				case opcode::subtract:
+					m_values[i] = x - y;
+					if constexpr (Gradient) {
+						m_d_lhs[i] = lane_type{ T(1.0) };
+						m_d_rhs[i] = lane_type{ T(-1.0) };
+					}
+					break;
+				case opcode::multiply:
+					m_values[i] = x * y;
+					if constexpr (Gradient) {
+						m_d_lhs[i] = y;
+						m_d_rhs[i] = x;
+					}
+					break;
+				case opcode::divide:
+				{
+					const lane_type inv = lane_type{ T(1.0) } / y;
+					m_values[i] = Detail::quotient(x, y, inv);
+					if constexpr (Gradient) {
+						m_d_lhs[i] = inv;
+						m_d_rhs[i] = -m_values[i] * inv;
+					}
+					break;
+				}
+				case opcode::negate:
+					m_values[i] = -x;
+					if constexpr (Gradient) m_d_lhs[i] = lane_type{ T(-1.0) };
+					break;
+				case opcode::add_constant:
+					m_values[i] = x + c;
+					if constexpr (Gradient) m_d_lhs[i] = lane_type{ T(1.0) };
+					break;
+				case opcode::subtract_constant:
+					m_values[i] = x - c;
+					if constexpr (Gradient) m_d_lhs[i] = lane_type{ T(1.0) };
+					break;
+				case opcode::constant_subtract:
+					m_values[i] = c - x;
+					if constexpr (Gradient) m_d_lhs[i] = lane_type{ T(-1.0) };
+					break;
+				case opcode::multiply_constant:
+					m_values[i] = x * c;
+					if constexpr (Gradient) m_d_lhs[i] = c;
+					break;
+				case opcode::divide_constant:
+					m_values[i] = x / c;
+					if constexpr (Gradient) m_d_lhs[i] = lane_type{ T(1.0) } / c;
+					break;
+				case opcode::constant_divide:
+				{
+					const lane_type inv = lane_type{ T(1.0) } / x;
+					m_values[i] = Detail::quotient(c, x, inv);
+					if constexpr (Gradient) m_d_lhs[i] = -m_values[i] * inv;
+					break;
+				}
+				case opcode::pow_constant:
+					unary<Gradient>(i, [e = in.constant](const auto& x) { return pow(x, e); });
+					break;
+				case opcode::pow_integer:
+					if constexpr (Gradient) {
+						unary<Gradient>(i, [n = in.exponent](const auto& x) { return pow(x, n); });
+					} else {
+						m_values[i] = pow(dual<lane_type>{ x, lane_type{} }, in.exponent).a();
+					}
+					break;
+				case opcode::constant_pow:
+					unary<Gradient>(i, [e = in.constant](const auto& x) { return pow(e, x); });
+					break;
+				case opcode::atan2:
+					binary<Gradient>(i, [](const auto& y, const auto& x) { return atan2(y, x); });
+					break;
+				case opcode::pow:
+					binary<Gradient>(i, [](const auto& f, const auto& y) { return pow(f, y); });
+					break;
+				case opcode::hypot:
+					binary<Gradient>(i, [](const auto& x, const auto& y) { return hypot(x, y); });
+					break;
+				case opcode::sqrt:
+					unary<Gradient>(i, [](const auto& x) { return sqrt(x); });
+					break;
+				case opcode::cbrt:
+					unary<Gradient>(i, [](const auto& x) { return cbrt(x); });
+					break;
+				case opcode::sin:
+					unary<Gradient>(i, [](const auto& x) { return sin(x); });
+					break;
+				case opcode::cos:
+					unary<Gradient>(i, [](const auto& x) { return cos(x); });
+					break;
+				case opcode::tan:
+					unary<Gradient>(i, [](const auto& x) { return tan(x); });
+					break;
+				case opcode::asin:
+					unary<Gradient>(i, [](const auto& x) { return asin(x); });
+					break;
+				case opcode::acos:
+					unary<Gradient>(i, [](const auto& x) { return acos(x); });
+					break;
+				case opcode::atan:
+					unary<Gradient>(i, [](const auto& x) { return atan(x); });
+					break;
+				case opcode::sinh:
+					unary<Gradient>(i, [](const auto& x) { return sinh(x); });
+					break;
+				case opcode::cosh:
+					unary<Gradient>(i, [](const auto& x) { return cosh(x); });
+					break;
+				case opcode::tanh:
+					unary<Gradient>(i, [](const auto& x) { return tanh(x); });
+					break;
+				case opcode::asinh:
+					unary<Gradient>(i, [](const auto& x) { return asinh(x); });
+					break;
+				case opcode::acosh:
+					unary<Gradient>(i, [](const auto& x) { return acosh(x); });
+					break;
+				case opcode::atanh:
+					unary<Gradient>(i, [](const auto& x) { return atanh(x); });
+					break;
+				case opcode::exp:
+					unary<Gradient>(i, [](const auto& x) { return exp(x); });
+					break;
+				case opcode::exp2:
+					unary<Gradient>(i, [](const auto& x) { return exp2(x); });
+					break;
+				case opcode::expm1:
+					unary<Gradient>(i, [](const auto& x) { return expm1(x); });
+					break;
+				case opcode::log:
+					unary<Gradient>(i, [](const auto& x) { return log(x); });
+					break;
+				case opcode::log1p:
+					unary<Gradient>(i, [](const auto& x) { return log1p(x); });
+					break;
+				case opcode::log10:
+					unary<Gradient>(i, [](const auto& x) { return log10(x); });
+					break;
+				case opcode::log2:
+					unary<Gradient>(i, [](const auto& x) { return log2(x); });
+					break;
+				}
+			}
+		}
+
+		/**
+		* 随伴値を逆順に伝播する
+		* @detail tape::backward()と同じく独立変数と1変数演算の第二の親は足し込まない
+		*         随伴値がゼロのレーンは足し込む値をゼロにする、ゼロと無限大の積のNaNを伝播させないため
+		*/
+		void backward() {
+			const lane_type zero{};
+
+			for (auto& adjoint : m_adjoints) adjoint = zero;
+			m_adjoints[m_output] = lane_type{ T(1.0) };
+
+			for (std::size_t i = m_code.size(); i-- > 0;) {
+				const instruction& in = m_code[i];
+				if (in.op == opcode::variable) continue;
+
+				const lane_type adjoint = m_adjoints[i];
+				const auto unused = adjoint == zero;
+
+				m_adjoints[in.lhs] += where(unused, zero, m_d_lhs[i] * adjoint);
+				if (is_binary(in.op)) m_adjoints[in.rhs] += where(unused, zero, m_d_rhs[i] * adjoint);
+			}
+		}
+
+		std::vector<instruction> m_code;
+		std::vector<index_type> m_inputs;
+		index_type m_output;
+
+		std::vector<lane_type> m_values;
+		std::vector<lane_type> m_d_lhs;
+		std::vector<lane_type> m_d_rhs;
+		std::vector<lane_type> m_adjoints;
+	};
+}
@@ -0,0 +1,194 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DualNumbers {
+
+	/**
+	* @brief ワークスティーリングを行うスレッドプール
+	* @detail スレッドは構築時に一度だけ起動し、parallel_for()の呼び出しをまたいで再利用する
+	*         タスクは各スレッドの両端キューに均等に配られ、自分のキューが空になったスレッドは他のキューの末尾から盗む
+	*         呼び出し元のスレッドもタスクを実行する
+	*/
+	class thread_pool {
+	public:
+
+		/**
+		* @param threads 起動するワーカースレッドの数、呼び出し元を合わせてthreads + 1個のスレッドで実行する
+		*/
+		explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()) - 1)
+			: m_queues(threads + 1)
+		{
+			m_workers.reserve(threads);
+			for (std::size_t i = 0; i < threads; ++i) {
+				m_workers.emplace_back([this, i] { worker(i); });
+			}
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		~thread_pool() {
+			{
+				std::lock_guard<std::mutex> lock{ m_mutex };
+				m_stop = true;
+			}
+			m_start.notify_all();
+
+			for (auto& worker : m_workers) worker.join();
+		}
+
+		/**
+		* 呼び出し元を含めた並列度
+		*/
+		std::size_t concurrency() const noexcept {
+			return m_queues.size();
+		}
+
+		/**
+		* [0, count)の各iについてf(i)を並列に実行し、全て終わるまで待つ
+		* @detail タスクの実行順序とスレッドへの割り当ては不定なので、fは書き込み先がiで決まるようにすること
+		*         fが例外を投げた場合、最初の例外を全タスクの終了後に呼び出し元で再送出する
+		*         実行中のタスクは1組だけなので、複数のスレッドからの呼び出しは順番に実行し、タスクの中からの入れ子の呼び出しはそのスレッドで逐次に実行する
+		* @param count タスクの数
+		* @param f タスク番号を受ける関数
+		*/
+		template<typename Func>
+		void parallel_for(std::size_t count, Func&& f) {
+			if (count == 0) return;
+
+			if (running_pool() == this) {
+				for (std::size_t i = 0; i < count; ++i) f(i);
+				return;
+			}
+
+			std::lock_guard<std::mutex> call_lock{ m_call_mutex };
+			std::unique_lock<std::mutex> lock{ m_mutex };
+
+			m_task = std::forward<Func>(f);
+			m_exception = nullptr;
+			m_remaining.store(count);
+
+			for (std::size_t q = 0; q < m_queues.size(); ++q) {
+				std::lock_guard<std::mutex> queue_lock{ m_queues[q].mutex };
+				for (std::size_t i = q; i < count; i += m_queues.size()) m_queues[q].tasks.push_back(i);
+			}
+
+			++m_generation;
+			lock.unlock();
+			m_start.notify_all();
+
+			run(m_queues.size() - 1);
+
+			lock.lock();
+			m_done.wait(lock, [this] { return m_remaining.load() == 0; });
+
+			m_task = nullptr;
+			if (m_exception) std::rethrow_exception(std::exchange(m_exception, nullptr));
+		}
+
+	private:
+
+		struct queue {
+			std::mutex mutex;
+			std::deque<std::size_t> tasks;
+		};
+
+		/**
+		* このスレッドがタスクを実行中のスレッドプール、入れ子のparallel_for()の検出に使う
+		*/
+		static const thread_pool*& running_pool() noexcept {
+			thread_local const thread_pool* pool = nullptr;
+			return pool;
+		}
+
+		void worker(std::size_t index) {
+			std::size_t generation = 0;
+
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock{ m_mutex };
+					m_start.wait(lock, [&] { return m_stop || generation != m_generation; });
+
+					if (m_stop) return;
+					generation = m_generation;
+				}
+
+				run(index);
+			}
+		}
+
+		/**
+		* 自分のキューの先頭から、空なら他のキューの末尾からタスクを取って実行する
+		*/
+		void run(std::size_t index) {
+			std::size_t task;
+
+			while (pop(index, task) || steal(index, task)) {
+				const thread_pool* outer = std::exchange(running_pool(), this);
+				try {
+					m_task(task);
+				} catch (...) {
+					std::lock_guard<std::mutex> lock{ m_mutex };
+					if (!m_exception) m_exception = std::current_exception();
+				}
+				running_pool() = outer;
+
+				if (m_remaining.fetch_sub(1) == 1) {
+					std::lock_guard<std::mutex> lock{ m_mutex };
+					m_done.notify_all();
+				}
+			}
+		}
+
+		bool pop(std::size_t index, std::size_t& task) {
+			auto& q = m_queues[index];
+			std::lock_guard<std::mutex> lock{ q.mutex };
+
+			if (q.tasks.empty()) return false;
+
+			task = q.tasks.front();
+			q.tasks.pop_front();
+			return true;
+		}
+
+		bool steal(std::size_t index, std::size_t& task) {
+			for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+				auto& q = m_queues[(index + offset) % m_queues.size()];
+				std::lock_guard<std::mutex> lock{ q.mutex };
+
+				if (q.tasks.empty()) continue;
+
+				task = q.tasks.back();
+				q.tasks.pop_back();
+				return true;
+			}
+
+			return false;
+		}
+
+		std::vector<queue> m_queues;
+		std::vector<std::thread> m_workers;
+
+		std::mutex m_call_mutex;
+		std::mutex m_mutex;
+		std::condition_variable m_start;
+		std::condition_variable m_done;
+		std::size_t m_generation = 0;
+		bool m_stop = false;
+
+		std::function<void(std::size_t)> m_task;
+		std::atomic<std::size_t> m_remaining{ 0 };
+		std::exception_ptr m_exception;
+	};
+}